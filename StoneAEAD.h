@@ -0,0 +1,206 @@
+#pragma once
+
+// file StoneAEAD.h
+//
+// StoneAEAD — single-pass authenticated encryption, duplex sponge over ChaCha
+//
+// • Header-only
+// • Constant-time
+// • No heap allocation
+// • Explicitly versioned (StoneAEAD::v1 is baked into the initial state)
+//
+// Encrypting with the ChaCha keystream and then authenticating with a separate
+// StoneHash pass reads and writes every byte twice. StoneAEAD instead runs one
+// keyed duplex sponge over the same ChaCha::permute_block() that StoneHash's
+// Compressor uses: each block of plaintext is XORed into the rate, the result
+// is the ciphertext, and the same state that produced the keystream absorbs
+// it. Encryption and authentication happen in one memory pass.
+//
+// Parameters (v1)
+//      state     64 bytes  (one ChaCha block, 16 × u32)
+//      rate      32 bytes  (words 0–7)
+//      capacity  32 bytes  (words 8–15) — 256-bit, conservative
+//      key       32 bytes, nonce 16 bytes, tag 32 bytes
+//
+// Layout
+//      init      state = "StoneAEAD::v1" ‖ key ‖ nonce;  F;  capacity ^= key
+//      AD        32-byte blocks, 10* padded, F after each; skipped if empty
+//                then state[63] ^= 0x80 (domain separation AD → message)
+//      message   rate ^= P, C = rate; F after each full block;
+//                last (partial or empty) block is 10* padded without F
+//      finalize  capacity ^= key;  F;  tag = capacity ^ key
+//
+// where F is ChaCha::permute_block (20 rounds plus feed-forward).
+//
+// The nonce must never repeat under one key: a repeat reveals the XOR of two
+// plaintexts up to and including their first differing block. Random
+// 128-bit nonces are fine for any realistic message count.
+//
+// Like StoneHash, this is a personal design without third-party cryptanalysis.
+// It follows the well-studied keyed-duplex pattern (Ascon, Xoodyak), but for
+// regulated use prefer a standardized AEAD (ChaCha20-Poly1305, AES-GCM).
+
+#define _CRT_DECLARE_NONSTDC_NAMES 1
+
+#include <cstring>
+#include <span>
+#include <stdexcept>
+
+#include "stBlock.h"
+#include "stChaCha.h"
+
+namespace st {
+
+    class StoneAEAD {
+    public:
+        static constexpr u32         VERSION = 1;
+        static constexpr std::size_t KEY_BYTES = 32;
+        static constexpr std::size_t NONCE_BYTES = 16;
+        static constexpr std::size_t TAG_BYTES = 32;
+        static constexpr std::size_t RATE_BYTES = 32;
+
+        using Nonce = Block<NONCE_BYTES>;
+
+        // Encrypt plaintext into ciphertext (same length; may be the same buffer)
+        // and return the authentication tag over ad and the ciphertext.
+        static Block32 encrypt(
+            const Block32&             key,
+            const Nonce&               nonce,
+            std::span<const std::byte> ad,
+            std::span<const std::byte> plaintext,
+            std::span<std::byte>       ciphertext)
+        {
+            if (ciphertext.size() < plaintext.size())
+                throw std::invalid_argument("StoneAEAD::encrypt: ciphertext buffer too small");
+
+            Block64 s = init(key, nonce, ad);
+
+            const std::byte* in = plaintext.data();
+            std::byte* out = ciphertext.data();
+            std::size_t len = plaintext.size();
+
+            while (len >= RATE_BYTES) {
+                u64 p[4];
+                std::memcpy(p, in, RATE_BYTES);
+                for (int i = 0; i < 4; ++i)
+                    s.u64[i] ^= p[i];
+                std::memcpy(out, s.u64, RATE_BYTES);
+                ChaCha::permute_block(s, s);
+                in += RATE_BYTES; out += RATE_BYTES; len -= RATE_BYTES;
+            }
+
+            for (std::size_t i = 0; i < len; ++i) {
+                s.bytes[i] ^= in[i];
+                out[i] = s.bytes[i];
+            }
+            s.bytes[len] ^= std::byte{ 0x01 };
+
+            return finalize(s, key);
+        }
+
+        // Verify the tag and decrypt. Returns false, with plaintext zeroed, if
+        // ad, ciphertext, nonce or tag were altered. Comparison is constant-time.
+        [[nodiscard]] static bool decrypt(
+            const Block32&             key,
+            const Nonce&               nonce,
+            std::span<const std::byte> ad,
+            std::span<const std::byte> ciphertext,
+            const Block32&             tag,
+            std::span<std::byte>       plaintext)
+        {
+            if (plaintext.size() < ciphertext.size())
+                throw std::invalid_argument("StoneAEAD::decrypt: plaintext buffer too small");
+
+            Block64 s = init(key, nonce, ad);
+
+            const std::byte* in = ciphertext.data();
+            std::byte* out = plaintext.data();
+            std::size_t len = ciphertext.size();
+
+            while (len >= RATE_BYTES) {
+                u64 c[4], p[4];
+                std::memcpy(c, in, RATE_BYTES);
+                for (int i = 0; i < 4; ++i) {
+                    p[i] = s.u64[i] ^ c[i];
+                    s.u64[i] = c[i];
+                }
+                std::memcpy(out, p, RATE_BYTES);
+                ChaCha::permute_block(s, s);
+                in += RATE_BYTES; out += RATE_BYTES; len -= RATE_BYTES;
+            }
+
+            for (std::size_t i = 0; i < len; ++i) {
+                const std::byte c = in[i];
+                out[i] = s.bytes[i] ^ c;
+                s.bytes[i] = c;
+            }
+            s.bytes[len] ^= std::byte{ 0x01 };
+
+            const Block32 expected = finalize(s, key);
+
+            u64 diff = 0;
+            for (std::size_t i = 0; i < Block32::size_in_u64(); ++i)
+                diff |= expected.u64[i] ^ tag.u64[i];
+
+            if (diff != 0) {
+                volatile std::byte* v = plaintext.data();
+                for (std::size_t i = 0; i < ciphertext.size(); ++i)
+                    v[i] = std::byte{ 0 };
+                return false;
+            }
+            return true;
+        }
+
+    private:
+        // Version string in the initial state: any change of layout or
+        // parameters gets a new version and therefore unrelated output.
+        static constexpr char IV[16] = { 'S','t','o','n','e','A','E','A','D',':',':','v','1',0,0,0 };
+
+        static void xor_key_into_capacity(Block64& s, const Block32& key) noexcept
+        {
+            for (int i = 0; i < 4; ++i)
+                s.u64[4 + i] ^= key.u64[i];
+        }
+
+        static Block64 init(const Block32& key, const Nonce& nonce, std::span<const std::byte> ad) noexcept
+        {
+            Block64 s{};
+            std::memcpy(s.bytes, IV, 16);
+            std::memcpy(s.bytes + 16, key.bytes, KEY_BYTES);
+            std::memcpy(s.bytes + 48, nonce.bytes, NONCE_BYTES);
+            ChaCha::permute_block(s, s);
+            xor_key_into_capacity(s, key);
+
+            if (!ad.empty()) {
+                const std::byte* p = ad.data();
+                std::size_t len = ad.size();
+                while (len >= RATE_BYTES) {
+                    for (std::size_t i = 0; i < RATE_BYTES; ++i)
+                        s.bytes[i] ^= p[i];
+                    ChaCha::permute_block(s, s);
+                    p += RATE_BYTES; len -= RATE_BYTES;
+                }
+                for (std::size_t i = 0; i < len; ++i)
+                    s.bytes[i] ^= p[i];
+                s.bytes[len] ^= std::byte{ 0x01 };
+                ChaCha::permute_block(s, s);
+            }
+
+            s.bytes[63] ^= std::byte{ 0x80 };
+            return s;
+        }
+
+        static Block32 finalize(Block64& s, const Block32& key) noexcept
+        {
+            xor_key_into_capacity(s, key);
+            ChaCha::permute_block(s, s);
+
+            Block32 tag;
+            for (int i = 0; i < 4; ++i)
+                tag.u64[i] = s.u64[4 + i] ^ key.u64[i];
+            s.clear();
+            return tag;
+        }
+    };//class StoneAEAD
+
+} // namespace st
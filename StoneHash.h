@@ -25,6 +25,7 @@
 
 #define _CRT_DECLARE_NONSTDC_NAMES 1
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cassert>
@@ -154,7 +155,9 @@ namespace st {
             requires std::is_trivially_copyable_v<T>
         StoneHash& update(const std::array<T, N>& arr) noexcept
         {
-            return update(std::as_bytes(std::span(arr)));
+            // Explicit dynamic extent: a span<const std::byte, N> would bind to
+            // update(const T&) above and hash the span object, not the array.
+            return update(std::span<const std::byte>(std::as_bytes(std::span(arr))));
         }
 
         template<class T>
@@ -174,25 +177,13 @@ namespace st {
         Block64 finalize() const noexcept
         {
             Compressor comp = comp_;       // copy compressor state
-            Block64    buffer = buffer_;   // copy partial input buffer
-            std::size_t pos = pos_;
-            u64 total_bits = total_bits_;
-
-            // Padding: single 0x80 bit + zero padding + 64-bit little-endian length
-            buffer.bytes[pos++] = std::byte{ 0x80 };
-            if (pos > BLOCK_SIZE_BYTES - 8) {
-                std::memset(buffer.bytes + pos, 0, BLOCK_SIZE_BYTES - pos);
-                comp.update(buffer);
-                pos = 0;
-            }
-            std::memset(buffer.bytes + pos, 0, (BLOCK_SIZE_BYTES - 8) - pos);
-            pos = BLOCK_SIZE_BYTES - 8;
+            Block64    pad[2];
 
-            for (int i = 0; i < 8; ++i)
-                buffer.bytes[pos + i] = std::byte(total_bits >> (i * 8));
+            const std::size_t n = pad_blocks(buffer_.bytes, pos_, total_bits_, pad);
+            for (std::size_t i = 0; i < n; ++i)
+                comp.update(pad[i]);
 
-            comp.update(buffer);
-            return comp.finalize(total_bits);
+            return comp.finalize(total_bits_);
         }
 
         // Return a 256-bit (32-byte) hash.
@@ -230,6 +221,63 @@ namespace st {
             return StoneHash(key).update(data).hash256();
         }
 
+        // Batch hashing: out[i] = hash(inputs[i], key) for every input.
+        // Inputs are taken HASH_LANES at a time and absorbed in lockstep by
+        // CompressorLanes, so a large number of short messages (file contents,
+        // set elements, records) is hashed with SIMD instead of one at a time.
+        // Inputs may have different lengths; out must be at least as long as inputs.
+        static constexpr std::size_t HASH_LANES = 8;
+
+        static void hash_many(
+            std::span<const std::span<const std::byte>> inputs,
+            std::span<Block32> out,
+            Block32 key = {}) noexcept
+        {
+            assert(out.size() >= inputs.size());
+            const StoneHash seed(key);
+
+            for (std::size_t first = 0; first < inputs.size(); first += HASH_LANES) {
+                const std::size_t n = std::min(HASH_LANES, inputs.size() - first);
+                CompressorLanes<HASH_LANES> lanes(seed.comp_);
+
+                // Each lane absorbs its full blocks followed by one or two padding blocks
+                std::size_t full[HASH_LANES]{};
+                std::size_t steps[HASH_LANES]{};
+                u64         total_bits[HASH_LANES]{};
+                Block64     pad[HASH_LANES][2];
+                std::size_t max_steps = 0;
+
+                for (std::size_t l = 0; l < n; ++l) {
+                    const auto in = inputs[first + l];
+                    full[l] = in.size() / BLOCK_SIZE_BYTES;
+                    total_bits[l] = u64(in.size()) * 8;
+                    steps[l] = full[l] + pad_blocks(in.data() + full[l] * BLOCK_SIZE_BYTES,
+                        in.size() % BLOCK_SIZE_BYTES, total_bits[l], pad[l]);
+                    max_steps = std::max(max_steps, steps[l]);
+                }
+
+                Block64 block[HASH_LANES];
+                for (std::size_t step = 0; step < max_steps; ++step) {
+                    const Block64* blocks[HASH_LANES]{};  // nullptr = lane finished
+                    for (std::size_t l = 0; l < n; ++l) {
+                        if (step < full[l]) {
+                            std::memcpy(block[l].bytes, inputs[first + l].data() + step * BLOCK_SIZE_BYTES, BLOCK_SIZE_BYTES);
+                            blocks[l] = &block[l];
+                        }
+                        else if (step < steps[l]) {
+                            blocks[l] = &pad[l][step - full[l]];
+                        }
+                    }
+                    lanes.update(blocks);
+                }
+
+                Block64 h[HASH_LANES];
+                lanes.finalize(total_bits, h);
+                for (std::size_t l = 0; l < n; ++l)
+                    std::memcpy(out[first + l].bytes, h[l].bytes, 32);
+            }
+        }
+
         // ================================================================
         // Cleanup
         // ================================================================
@@ -247,6 +295,31 @@ namespace st {
         std::size_t pos_ = 0;
         u64         total_bits_ = 0;
 
+        // ----------------------------------------------------------------
+        // Padding: single 0x80 bit + zero padding + 64-bit little-endian length.
+        // Builds the final block(s) for a message whose unabsorbed tail is
+        // tail[0..len), len < 64. Returns the number of blocks written (1 or 2).
+        // ----------------------------------------------------------------
+        static std::size_t pad_blocks(const std::byte* tail, std::size_t len,
+            u64 total_bits, Block64 (&out)[2]) noexcept
+        {
+            out[0].clear();
+            out[1].clear();
+            if (len > 0)
+                std::memcpy(out[0].bytes, tail, len);
+
+            std::size_t n = 0;
+            std::size_t pos = len;
+            out[0].bytes[pos++] = std::byte{ 0x80 };
+            if (pos > BLOCK_SIZE_BYTES - 8)
+                n = 1;  // no room for the length: it goes in a second block
+
+            for (int i = 0; i < 8; ++i)
+                out[n].bytes[BLOCK_SIZE_BYTES - 8 + i] = std::byte(total_bits >> (i * 8));
+
+            return n + 1;
+        }
+
         // ----------------------------------------------------------------
         // Key setup — BLAKE3 IV + key + optional second block to kill fixed points
         // ----------------------------------------------------------------
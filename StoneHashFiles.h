@@ -0,0 +1,577 @@
+#pragma once
+// file StoneHashFiles.h
+//
+// hash_files() — StoneHash digests for a large list of files.
+//
+// For trees with many small files the cost is in open/read/close system calls,
+// not in StoneHash. Two backends are provided:
+//
+//   • io_uring (Linux 5.6+) — openat, statx, read and close are submitted in
+//     batches through a submission ring, reads land in registered buffers, and
+//     completed small files are hashed HASH_LANES at a time with
+//     StoneHash::hash_many(). Uses raw system calls: no liburing needed.
+//
+//   • Thread pool — blocking fopen/fread on N worker threads. Used on every
+//     other platform, and on Linux when io_uring is missing or forbidden
+//     (old kernel, seccomp, io_uring_disabled sysctl, ...).
+//
+// Both backends produce exactly StoneHash(key).update(file contents).hash256().
+// The io_uring backend uses the statx size only to pick batch or streaming
+// hashing; it reads until end of file, so /proc files and files that grow or
+// shrink while being hashed give the same result as the thread pool.
+
+#define _CRT_DECLARE_NONSTDC_NAMES 1
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <filesystem>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "StoneHash.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define STONEHASH_HAVE_IO_URING 1
+#include <fcntl.h>          // AT_FDCWD, O_RDONLY
+#include <linux/io_uring.h> // ring layout, opcodes
+#include <sys/mman.h>       // mmap
+#include <sys/stat.h>       // struct statx
+#include <sys/syscall.h>    // __NR_io_uring_*
+#include <sys/uio.h>        // struct iovec
+#include <unistd.h>         // syscall, close
+#else
+#define STONEHASH_HAVE_IO_URING 0
+#endif
+
+namespace st {
+
+    // Result for one file. On failure digest is zero and error holds the errno value.
+    struct FileDigest {
+        Block32 digest{};
+        int     error = 0;
+    };
+
+    enum class HashFilesBackend { Auto, IoUring, Threads };
+
+    struct HashFilesOptions {
+        Block32          key{};                  // zero key = unkeyed, as StoneHash()
+        unsigned         queue_depth = 64;       // files in flight (io_uring)
+        std::size_t      chunk_bytes = 64 * 1024;// read size; files below this size are batch-hashed
+        unsigned         threads = 0;            // pool size (threads backend); 0 = hardware_concurrency
+        HashFilesBackend backend = HashFilesBackend::Auto;
+    };
+
+    namespace HashFiles {
+
+        // ================================================================
+        // Thread pool backend (portable)
+        // ================================================================
+
+        inline void hash_one(const std::filesystem::path& path, const HashFilesOptions& opt,
+            std::vector<std::byte>& buf, FileDigest& out) noexcept
+        {
+            errno = 0;
+#if defined(_WIN32)
+            std::FILE* f = _wfopen(path.c_str(), L"rb");
+#else
+            std::FILE* f = std::fopen(path.c_str(), "rb");
+#endif
+            if (!f) {
+                out.error = errno ? errno : ENOENT;
+                return;
+            }
+
+            StoneHash h(opt.key);
+            std::size_t got;
+            while ((got = std::fread(buf.data(), 1, buf.size(), f)) > 0)
+                h.update(std::span<const std::byte>(buf.data(), got));
+
+            if (std::ferror(f))
+                out.error = errno ? errno : EIO;
+            else
+                out.digest = h.hash256();
+            std::fclose(f);
+        }
+
+        inline void hash_threaded(std::span<const std::filesystem::path> paths,
+            const HashFilesOptions& opt, std::span<FileDigest> out)
+        {
+            unsigned n_threads = opt.threads ? opt.threads : std::thread::hardware_concurrency();
+            n_threads = std::max(1u, n_threads);
+            if (n_threads > paths.size())
+                n_threads = static_cast<unsigned>(std::max<std::size_t>(1, paths.size()));
+
+            std::atomic<std::size_t> next{ 0 };
+            auto worker = [&]() {
+                std::vector<std::byte> buf(std::max<std::size_t>(opt.chunk_bytes, StoneHash::BLOCK_SIZE_BYTES));
+                for (std::size_t i = next++; i < paths.size(); i = next++)
+                    hash_one(paths[i], opt, buf, out[i]);
+                };
+
+            std::vector<std::thread> pool;
+            for (unsigned t = 1; t < n_threads; ++t)
+                pool.emplace_back(worker);
+            worker();
+            for (auto& t : pool)
+                t.join();
+        }
+
+#if STONEHASH_HAVE_IO_URING
+        // ================================================================
+        // io_uring backend (Linux)
+        // ================================================================
+
+        // Minimal io_uring ring: setup, mmap, submit, reap. Raw system calls only.
+        class Ring {
+            int         fd_ = -1;
+            void*       sq_ptr_ = MAP_FAILED;
+            void*       cq_ptr_ = MAP_FAILED;
+            std::size_t sq_len_ = 0, cq_len_ = 0, sqes_len_ = 0;
+
+            unsigned*     sq_head_ = nullptr;
+            unsigned*     sq_tail_ = nullptr;
+            unsigned*     sq_array_ = nullptr;
+            unsigned      sq_mask_ = 0, sq_entries_ = 0;
+            io_uring_sqe* sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+
+            unsigned*     cq_head_ = nullptr;
+            unsigned*     cq_tail_ = nullptr;
+            unsigned      cq_mask_ = 0;
+            io_uring_cqe* cqes_ = nullptr;
+
+            unsigned tail_ = 0;       // local SQ tail, published by submit()
+            unsigned to_submit_ = 0;
+
+        public:
+            explicit Ring(unsigned entries) noexcept
+            {
+                io_uring_params p{};
+                fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &p));
+                if (fd_ < 0)
+                    return;
+
+                sq_len_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+                cq_len_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+                const bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (single)
+                    sq_len_ = cq_len_ = std::max(sq_len_, cq_len_);
+
+                sq_ptr_ = ::mmap(nullptr, sq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+                if (sq_ptr_ == MAP_FAILED) {
+                    close_ring();
+                    return;
+                }
+                if (single) {
+                    cq_ptr_ = sq_ptr_;
+                }
+                else {
+                    cq_ptr_ = ::mmap(nullptr, cq_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+                    if (cq_ptr_ == MAP_FAILED) {
+                        close_ring();
+                        return;
+                    }
+                }
+                sqes_len_ = p.sq_entries * sizeof(io_uring_sqe);
+                sqes_ = static_cast<io_uring_sqe*>(::mmap(nullptr, sqes_len_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQES));
+                if (sqes_ == MAP_FAILED) {
+                    close_ring();
+                    return;
+                }
+
+                auto* sq = static_cast<char*>(sq_ptr_);
+                sq_head_ = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+                sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+                sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+                sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+                sq_entries_ = p.sq_entries;
+                tail_ = *sq_tail_;
+
+                auto* cq = static_cast<char*>(cq_ptr_);
+                cq_head_ = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+                cq_tail_ = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+                cq_mask_ = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+                cqes_ = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+            }
+
+            ~Ring() { close_ring(); }
+
+            Ring(const Ring&) = delete;
+            Ring& operator=(const Ring&) = delete;
+
+            bool ok() const noexcept { return fd_ >= 0; }
+
+            // True if the kernel implements every opcode hash_uring() uses.
+            bool supports(std::initializer_list<int> ops) const noexcept
+            {
+                constexpr unsigned N = 256;
+                alignas(io_uring_probe) unsigned char raw[sizeof(io_uring_probe) + N * sizeof(io_uring_probe_op)]{};
+                auto* probe = reinterpret_cast<io_uring_probe*>(raw);
+                if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, N) < 0)
+                    return false;
+                for (int op : ops) {
+                    if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+                        return false;
+                }
+                return true;
+            }
+
+            bool register_buffers(const iovec* iov, unsigned n) noexcept
+            {
+                return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, iov, n) == 0;
+            }
+
+            // Next free submission entry, zeroed. The caller never queues more
+            // than the ring holds, so this cannot run out.
+            io_uring_sqe* get_sqe() noexcept
+            {
+                const unsigned head = std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+                assert(tail_ - head < sq_entries_);
+                (void)head;
+                const unsigned idx = tail_ & sq_mask_;
+                io_uring_sqe* sqe = &sqes_[idx];
+                std::memset(sqe, 0, sizeof(*sqe));
+                sq_array_[idx] = idx;
+                ++tail_;
+                ++to_submit_;
+                return sqe;
+            }
+
+            // Publish queued entries and wait until at least one completion is ready.
+            void submit_and_wait()
+            {
+                if (!try_submit_and_wait())
+                    throw std::runtime_error("hash_files: io_uring_enter failed");
+            }
+
+            // As submit_and_wait(), but reports a hard failure instead of throwing.
+            bool try_submit_and_wait() noexcept
+            {
+                std::atomic_ref<unsigned>(*sq_tail_).store(tail_, std::memory_order_release);
+                for (;;) {
+                    const long r = ::syscall(__NR_io_uring_enter, fd_, to_submit_, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+                    if (r >= 0) {
+                        to_submit_ -= static_cast<unsigned>(r);
+                        if (to_submit_ == 0)
+                            return true;
+                    }
+                    else if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                        return false;
+                    }
+                }
+            }
+
+            // Call fn(user_data, res) for each available completion.
+            template <class Fn>
+            void reap(Fn&& fn)
+            {
+                unsigned head = *cq_head_;
+                const unsigned tail = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+                for (; head != tail; ++head) {
+                    const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+                    fn(cqe.user_data, cqe.res);
+                }
+                std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+            }
+
+        private:
+            void close_ring() noexcept
+            {
+                if (sqes_ != MAP_FAILED) ::munmap(sqes_, sqes_len_);
+                if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) ::munmap(cq_ptr_, cq_len_);
+                if (sq_ptr_ != MAP_FAILED) ::munmap(sq_ptr_, sq_len_);
+                sqes_ = static_cast<io_uring_sqe*>(MAP_FAILED);
+                cq_ptr_ = sq_ptr_ = MAP_FAILED;
+                if (fd_ >= 0) ::close(fd_);
+                fd_ = -1;
+            }
+        };
+
+        // Hash paths with io_uring. Returns false, without touching out, if
+        // io_uring cannot be used on this system.
+        inline bool hash_uring(std::span<const std::filesystem::path> paths,
+            const HashFilesOptions& opt, std::span<FileDigest> out)
+        {
+            const unsigned depth = std::max(opt.queue_depth, unsigned(StoneHash::HASH_LANES));
+            const std::size_t chunk = std::max<std::size_t>(opt.chunk_bytes, StoneHash::BLOCK_SIZE_BYTES);
+
+            enum Op : u64 { OPEN, STAT, READ, CLOSE };
+            enum Stage { FREE, OPENING, READING, BATCHED, DONE };
+
+            struct Slot {
+                Stage        stage = FREE;
+                std::size_t  file = 0;        // index into paths / out
+                int          inflight = 0;    // requests not yet completed
+                int          fd = -1;
+                int          error = 0;
+                u64          size = 0;        // from statx; a hint only
+                u64          offset = 0;      // bytes read so far
+                bool         streaming = false; // does not fit in one chunk
+                std::byte*   buf = nullptr;
+                struct statx stx {};
+                StoneHash    hasher;
+            };
+
+            std::vector<std::byte> arena(depth * chunk);
+            std::vector<Slot> slots(depth);
+            std::vector<iovec> iov(depth);
+            for (unsigned s = 0; s < depth; ++s) {
+                slots[s].buf = arena.data() + s * chunk;
+                iov[s] = { slots[s].buf, chunk };
+            }
+
+            // Declared after the buffers so that it is torn down first.
+            // Each file has at most two requests in flight (openat + statx).
+            Ring ring(2 * depth);
+            if (!ring.ok())
+                return false;
+            if (!ring.supports({ IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_READ_FIXED, IORING_OP_CLOSE }))
+                return false;
+
+            // Registered buffers skip the per-read page pinning. They count
+            // against RLIMIT_MEMLOCK on older kernels; plain reads are the fallback.
+            const bool fixed = ring.register_buffers(iov.data(), depth);
+
+            std::size_t next = 0;       // next file to start
+            std::size_t finished = 0;   // results written to out
+            std::size_t outstanding = 0;
+            std::vector<unsigned> batch;  // slots waiting for hash_many()
+            batch.reserve(StoneHash::HASH_LANES);
+
+            auto tag = [](unsigned s, Op op) { return (u64(s) << 8) | op; };
+
+            auto finish = [&](Slot& sl) {
+                if (sl.error)
+                    out[sl.file].error = sl.error;
+                ++finished;
+                sl.stage = DONE;
+                };
+
+            auto release_if_idle = [&](Slot& sl) {
+                if (sl.stage == DONE && sl.inflight == 0)
+                    sl.stage = FREE;
+                };
+
+            auto submit_close = [&](unsigned s) {
+                Slot& sl = slots[s];
+                if (sl.fd < 0)
+                    return;
+                io_uring_sqe* sqe = ring.get_sqe();
+                sqe->opcode = IORING_OP_CLOSE;
+                sqe->fd = sl.fd;
+                sqe->user_data = tag(s, CLOSE);
+                sl.fd = -1;
+                ++sl.inflight; ++outstanding;
+                };
+
+            auto submit_read = [&](unsigned s) {
+                Slot& sl = slots[s];
+                // small files accumulate in the buffer, large ones reuse it per chunk
+                const u64 at = sl.streaming ? 0 : sl.offset;
+                io_uring_sqe* sqe = ring.get_sqe();
+                sqe->opcode = fixed ? IORING_OP_READ_FIXED : IORING_OP_READ;
+                sqe->fd = sl.fd;
+                sqe->addr = reinterpret_cast<u64>(sl.buf + at);
+                sqe->len = static_cast<u32>(chunk - at);
+                sqe->off = sl.offset;
+                sqe->buf_index = static_cast<u16>(s);
+                sqe->user_data = tag(s, READ);
+                ++sl.inflight; ++outstanding;
+                };
+
+            auto start = [&](unsigned s, std::size_t file) {
+                Slot& sl = slots[s];
+                sl.stage = OPENING;
+                sl.file = file;
+                sl.fd = -1;
+                sl.error = 0;
+                sl.size = sl.offset = 0;
+
+                const char* path = paths[file].c_str();
+
+                io_uring_sqe* sqe = ring.get_sqe();
+                sqe->opcode = IORING_OP_OPENAT;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = reinterpret_cast<u64>(path);
+                sqe->open_flags = O_RDONLY | O_CLOEXEC;
+                sqe->user_data = tag(s, OPEN);
+
+                sqe = ring.get_sqe();
+                sqe->opcode = IORING_OP_STATX;
+                sqe->fd = AT_FDCWD;
+                sqe->addr = reinterpret_cast<u64>(path);
+                sqe->len = STATX_SIZE;
+                sqe->off = reinterpret_cast<u64>(&sl.stx);
+                sqe->user_data = tag(s, STAT);
+
+                sl.inflight += 2; outstanding += 2;
+                };
+
+            // A small file is fully in its buffer: close it and queue it for hashing.
+            auto hash_batch = [&]() {
+                std::span<const std::byte> in[StoneHash::HASH_LANES];
+                Block32 digest[StoneHash::HASH_LANES];
+                for (std::size_t i = 0; i < batch.size(); ++i)
+                    in[i] = { slots[batch[i]].buf, slots[batch[i]].offset };
+
+                StoneHash::hash_many({ in, batch.size() }, { digest, batch.size() }, opt.key);
+
+                for (std::size_t i = 0; i < batch.size(); ++i) {
+                    Slot& sl = slots[batch[i]];
+                    out[sl.file].digest = digest[i];
+                    finish(sl);
+                    release_if_idle(sl);
+                }
+                batch.clear();
+                };
+
+            auto end_of_file = [&](unsigned s) {
+                Slot& sl = slots[s];
+                submit_close(s);
+                if (sl.error) {
+                    finish(sl);
+                }
+                else if (sl.streaming) {
+                    out[sl.file].digest = sl.hasher.hash256();
+                    sl.hasher.wipe();
+                    finish(sl);
+                }
+                else {
+                    sl.stage = BATCHED;
+                    batch.push_back(s);
+                    if (batch.size() == StoneHash::HASH_LANES)
+                        hash_batch();
+                }
+                };
+
+            auto on_complete = [&](u64 user_data, int res) {
+                const unsigned s = static_cast<unsigned>(user_data >> 8);
+                const Op op = static_cast<Op>(user_data & 0xff);
+                Slot& sl = slots[s];
+                --sl.inflight; --outstanding;
+
+                switch (op) {
+                case OPEN:
+                    if (res < 0) sl.error = -res;
+                    else sl.fd = res;
+                    break;
+                case STAT:
+                    if (res < 0) sl.error = -res;
+                    else sl.size = sl.stx.stx_size;
+                    break;
+                case READ:
+                    if (res < 0) {
+                        sl.error = -res;
+                        end_of_file(s);
+                        break;
+                    }
+                    // only a zero-length read ends the file: statx sizes can be
+                    // stale (growing files) or simply wrong (/proc, /sys)
+                    if (res == 0) {
+                        end_of_file(s);
+                        break;
+                    }
+                    if (sl.streaming)
+                        sl.hasher.update(std::span<const std::byte>(sl.buf, static_cast<std::size_t>(res)));
+                    sl.offset += static_cast<u64>(res);
+                    if (!sl.streaming && sl.offset == chunk) {
+                        // buffer full and not at end of file: continue as a stream
+                        sl.streaming = true;
+                        sl.hasher = StoneHash(opt.key);
+                        sl.hasher.update(std::span<const std::byte>(sl.buf, chunk));
+                    }
+                    submit_read(s);
+                    break;
+                case CLOSE:
+                    break;
+                }
+
+                // openat and statx both back: begin reading
+                if (sl.stage == OPENING && sl.inflight == 0) {
+                    sl.stage = READING;
+                    sl.streaming = sl.size > chunk;
+                    if (sl.streaming)
+                        sl.hasher = StoneHash(opt.key);
+                    if (sl.error)
+                        end_of_file(s);
+                    else
+                        submit_read(s);
+                }
+                release_if_idle(sl);
+                };
+
+            // Error path: wait for everything already submitted, so that no
+            // openat, statx or read can still land in slots or arena, and
+            // close every descriptor the ring opened for us.
+            auto drain = [&]() noexcept {
+                while (outstanding > 0 && ring.try_submit_and_wait()) {
+                    ring.reap([&](u64 user_data, int res) {
+                        --outstanding;
+                        if ((user_data & 0xff) == OPEN && res >= 0)
+                            ::close(res);
+                        });
+                }
+                for (Slot& sl : slots) {
+                    if (sl.fd >= 0)
+                        ::close(sl.fd);
+                    sl.fd = -1;
+                }
+                };
+
+            try {
+                // Keep going until the ring is empty, not just until every
+                // result is in: the last completions queue CLOSE requests.
+                while (finished < paths.size() || outstanding > 0) {
+                    for (unsigned s = 0; s < depth && next < paths.size(); ++s) {
+                        if (slots[s].stage == FREE)
+                            start(s, next++);
+                    }
+
+                    if (outstanding == 0) {
+                        // only batched files are left holding slots
+                        hash_batch();
+                        continue;
+                    }
+
+                    ring.submit_and_wait();
+                    ring.reap(on_complete);
+                }
+            }
+            catch (...) {
+                drain();
+                throw;
+            }
+            return true;
+        }
+#endif // STONEHASH_HAVE_IO_URING
+
+    }// namespace HashFiles
+
+    // Hash every file in paths. out[i] belongs to paths[i].
+    // Per-file failures (missing file, permission denied, ...) are reported in
+    // FileDigest::error and do not stop the others.
+    inline std::vector<FileDigest> hash_files(
+        std::span<const std::filesystem::path> paths,
+        const HashFilesOptions& opt = {})
+    {
+        std::vector<FileDigest> out(paths.size());
+        if (paths.empty())
+            return out;
+
+#if STONEHASH_HAVE_IO_URING
+        if (opt.backend != HashFilesBackend::Threads && HashFiles::hash_uring(paths, opt, out))
+            return out;
+        if (opt.backend == HashFilesBackend::IoUring)
+            throw std::runtime_error("hash_files: io_uring is not available");
+#else
+        if (opt.backend == HashFilesBackend::IoUring)
+            throw std::runtime_error("hash_files: io_uring is not available on this platform");
+#endif
+
+        HashFiles::hash_threaded(paths, opt, out);
+        return out;
+    }
+
+} // namespace st
@@ -192,4 +192,26 @@ namespace st {
         return out.hash256();
     }// StoneKey
 
+    //
+    // StoneKeyVerify(expected, password, context = {})
+    // ---------------------------------------------------------------------
+    // Login-style check: re-derive the key and compare it with a stored one.
+    // The comparison is constant-time; the derivation itself costs exactly one
+    // StoneKey() call with the same m_cost / t_cost, so size servers with that.
+    // ---------------------------------------------------------------------
+    [[nodiscard]] inline bool StoneKeyVerify(
+        const Block32&   expected,
+        std::string_view password,
+        std::string_view context = {},
+        uint32_t         m_cost = STONEKEY_V2_M_COST,
+        uint32_t         t_cost = STONEKEY_V2_T_COST)
+    {
+        const Block32 key = StoneKey(password, context, m_cost, t_cost);
+
+        uint64_t diff = 0;
+        for (std::size_t i = 0; i < Block32::size_in_u64(); ++i)
+            diff |= key.u64[i] ^ expected.u64[i];
+        return diff == 0;
+    }
+
 }// namespace st
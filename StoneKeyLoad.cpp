@@ -0,0 +1,520 @@
+// file StoneKeyLoad.cpp -- load generator and SLO harness for StoneKeyVerify()
+//
+// Replays login-style traffic against StoneKeyVerify() in this process to size
+// hardware for a verification service. For each m_cost/t_cost profile it
+// reports latency percentiles (HDR-style histogram), throughput and peak
+// memory, and can search for the highest request rate that still meets a p99
+// latency bound.
+//
+// Arrivals are open-loop by default: request i is due at a scheduled time
+// (Poisson process at the target rate) whether or not earlier ones finished,
+// and its latency is measured from that scheduled time. Queueing delay is
+// therefore included, and an overloaded server shows up as a growing p99
+// instead of being hidden by a slower sender (coordinated omission). When the
+// run ends, arrivals stop but everything already queued is still served and
+// recorded, so the tail is not cut off; the time that takes is reported as
+// the drain time.
+// --concurrency switches to closed-loop: N workers verify back-to-back.
+//
+// Build:
+//      g++ -std=c++20 -O2 -pthread StoneKeyLoad.cpp -o stonekey_load
+//
+// Examples:
+//      stonekey_load --profile 16,2 --qps 40 --duration 20
+//      stonekey_load --profile 14,1 --profile 16,2 --profile 20,3 --sweep --p99-ms 250
+//      stonekey_load --profile 18,3 --concurrency 8
+
+#define _CRT_DECLARE_NONSTDC_NAMES 1
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StoneKey.h"
+#include "StoneRNG.h"
+
+#if defined(_WIN32)
+#include "windows_fix.h"
+#include <psapi.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+// ============================================================================
+// Latency histogram
+// ============================================================================
+//
+// Log-linear buckets in the style of HdrHistogram: values below 128 are exact,
+// above that every power-of-two range is split into 64 buckets, so every
+// recorded value is kept to within 1/64 (~1.6%). Values are microseconds.
+class LatencyHistogram {
+    static constexpr int SUB_BITS = 7;                   // 128 exact values
+    static constexpr std::uint64_t SUB = 1ull << SUB_BITS;
+    static constexpr std::uint64_t HALF = SUB / 2;
+    static constexpr std::size_t BUCKETS = SUB + (64 - SUB_BITS) * HALF;
+
+    std::array<std::uint64_t, BUCKETS> counts_{};
+    std::uint64_t total_ = 0;
+    std::uint64_t max_ = 0;
+
+    static std::size_t index_of(std::uint64_t v) noexcept
+    {
+        if (v < SUB) return static_cast<std::size_t>(v);
+        const int e = std::bit_width(v) - SUB_BITS;       // >= 1
+        return static_cast<std::size_t>(SUB + (e - 1) * HALF + ((v >> e) - HALF));
+    }
+
+    // Largest value that maps to bucket i
+    static std::uint64_t value_of(std::size_t i) noexcept
+    {
+        if (i < SUB) return i;
+        const int e = static_cast<int>((i - SUB) / HALF) + 1;
+        const std::uint64_t m = (i - SUB) % HALF + HALF;
+        return ((m + 1) << e) - 1;
+    }
+
+public:
+    void record(std::uint64_t us) noexcept
+    {
+        ++counts_[index_of(us)];
+        ++total_;
+        max_ = std::max(max_, us);
+    }
+
+    void merge(const LatencyHistogram& o) noexcept
+    {
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+            counts_[i] += o.counts_[i];
+        total_ += o.total_;
+        max_ = std::max(max_, o.max_);
+    }
+
+    std::uint64_t count() const noexcept { return total_; }
+    std::uint64_t max() const noexcept { return max_; }
+
+    // Value at quantile q in [0, 1]
+    std::uint64_t percentile(double q) const noexcept
+    {
+        if (total_ == 0) return 0;
+        const auto rank = static_cast<std::uint64_t>(q * double(total_ - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= rank)
+                return std::min(value_of(i), max_);
+        }
+        return max_;
+    }
+};
+
+// ============================================================================
+// Peak memory (resident set high-water mark)
+// ============================================================================
+
+#if defined(_WIN32)
+inline std::uint64_t peak_rss_bytes()
+{
+    PROCESS_MEMORY_COUNTERS pmc{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+        return pmc.PeakWorkingSetSize;
+    return 0;
+}
+inline void reset_peak_rss() {} // not supported: peak is process lifetime
+#elif defined(__linux__)
+inline std::uint64_t peak_rss_bytes()
+{
+    std::ifstream f("/proc/self/status");
+    std::string line;
+    while (std::getline(f, line)) {
+        if (line.rfind("VmHWM:", 0) == 0)
+            return std::strtoull(line.c_str() + 6, nullptr, 10) * 1024; // kB
+    }
+    return 0;
+}
+// Writing 5 to clear_refs resets VmHWM to the current RSS (Linux 4.0+).
+inline void reset_peak_rss()
+{
+    std::ofstream("/proc/self/clear_refs") << "5";
+}
+#else
+#include <sys/resource.h>
+inline std::uint64_t peak_rss_bytes()
+{
+    rusage ru{};
+    getrusage(RUSAGE_SELF, &ru);
+    return static_cast<std::uint64_t>(ru.ru_maxrss); // bytes on macOS
+}
+inline void reset_peak_rss() {}
+#endif
+
+// ============================================================================
+// Workload
+// ============================================================================
+
+struct Profile {
+    std::uint32_t m_cost;
+    std::uint32_t t_cost;
+};
+
+// A small population of accounts with known stored keys. A fraction of the
+// attempts use a wrong password, as real login traffic does; both cost the same.
+struct Workload {
+    struct Account {
+        std::string user;
+        std::string password;
+        st::Block32 stored;
+    };
+    std::vector<Account> accounts;
+    double wrong_fraction = 0.1;
+
+    Workload(const Profile& p, std::size_t n_accounts)
+    {
+        for (std::size_t i = 0; i < n_accounts; ++i) {
+            Account a;
+            a.user = "user" + std::to_string(i) + "@example.com";
+            a.password = "correct horse battery staple #" + std::to_string(i);
+            a.stored = st::StoneKey(a.password, a.user, p.m_cost, p.t_cost);
+            accounts.push_back(std::move(a));
+        }
+    }
+};
+
+struct Request {
+    Clock::time_point due;   // scheduled arrival (open loop) or start (closed loop)
+    std::size_t account;
+    bool wrong;
+};
+
+struct RunResult {
+    LatencyHistogram hist;
+    std::uint64_t completed = 0;
+    std::uint64_t backlog = 0;   // queued when arrivals stopped (served during the drain)
+    std::uint64_t abandoned = 0; // still queued when the drain cap ran out
+    std::uint64_t failures = 0;  // verify result did not match expectation
+    double seconds = 0;
+    double drain_s = 0;          // from the end of arrivals to the last completion
+    std::uint64_t peak_rss = 0;
+
+    double throughput() const { return seconds > 0 ? completed / seconds : 0; }
+    double p99_ms() const { return hist.percentile(0.99) / 1000.0; }
+    double drain_ms() const { return drain_s * 1000.0; }
+};
+
+inline bool verify_one(const Workload& w, const Profile& p, const Request& r)
+{
+    const auto& a = w.accounts[r.account];
+    const std::string pw = r.wrong ? a.password + "!" : a.password;
+    return st::StoneKeyVerify(a.stored, pw, a.user, p.m_cost, p.t_cost) != r.wrong;
+}
+
+// Open loop: a scheduler thread enqueues requests at Poisson arrival times,
+// `threads` workers serve them. Latency = completion - scheduled arrival.
+// Arrivals stop after duration_s; the queue is then drained, for at most
+// another duration_s so that a badly overloaded run still terminates.
+inline RunResult run_open_loop(const Workload& w, const Profile& p, double qps,
+    double duration_s, unsigned threads, std::uint64_t seed)
+{
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::condition_variable drained;
+    std::deque<Request> queue;
+    bool closing = false;
+
+    RunResult result;
+    std::vector<LatencyHistogram> hists(threads);
+    std::atomic<std::uint64_t> completed{ 0 }, failures{ 0 };
+
+    reset_peak_rss();
+
+    auto worker = [&](unsigned id) {
+        for (;;) {
+            Request r;
+            {
+                std::unique_lock lock(mtx);
+                cv.wait(lock, [&] { return closing || !queue.empty(); });
+                if (queue.empty()) return;
+                r = queue.front();
+                queue.pop_front();
+                if (closing && queue.empty())
+                    drained.notify_one();
+            }
+            if (!verify_one(w, p, r)) ++failures;
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - r.due).count();
+            hists[id].record(static_cast<std::uint64_t>(std::max<long long>(0, us)));
+            ++completed;
+        }
+        };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t)
+        pool.emplace_back(worker, t);
+
+    st::StoneRNG rng(seed);  // deterministic arrivals and account choice
+    std::exponential_distribution<double> gap(qps);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    const auto start = Clock::now();
+    const auto stop = start + std::chrono::duration<double>(duration_s);
+    auto due = start;
+    for (;;) {
+        due += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(gap(rng)));
+        if (due >= stop) break;
+        std::this_thread::sleep_until(due);
+
+        Request r{ due, static_cast<std::size_t>(rng.unbiased(0, w.accounts.size() - 1)), unit(rng) < w.wrong_fraction };
+        {
+            std::lock_guard lock(mtx);
+            queue.push_back(r);
+        }
+        cv.notify_one();
+    }
+    std::this_thread::sleep_until(stop);
+
+    // No more arrivals. Requests still queued are served and recorded from
+    // their scheduled times: they are the tail this run exists to measure.
+    {
+        std::unique_lock lock(mtx);
+        result.backlog = queue.size();
+        closing = true;
+        cv.notify_all();
+        const auto cap = stop + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(duration_s));
+        if (!drained.wait_until(lock, cap, [&] { return queue.empty(); })) {
+            result.abandoned = queue.size();
+            queue.clear();
+        }
+    }
+    for (auto& t : pool) t.join();
+
+    const auto end = Clock::now();
+    result.drain_s = std::chrono::duration<double>(end - stop).count();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    for (auto& h : hists) result.hist.merge(h);
+    result.completed = completed;
+    result.failures = failures;
+    result.peak_rss = peak_rss_bytes();
+    return result;
+}
+
+// Closed loop: `concurrency` workers verify back-to-back for duration_s.
+inline RunResult run_closed_loop(const Workload& w, const Profile& p,
+    unsigned concurrency, double duration_s, std::uint64_t seed)
+{
+    RunResult result;
+    std::vector<LatencyHistogram> hists(concurrency);
+    std::atomic<std::uint64_t> completed{ 0 }, failures{ 0 };
+
+    reset_peak_rss();
+    const auto start = Clock::now();
+    const auto stop = start + std::chrono::duration<double>(duration_s);
+
+    auto worker = [&](unsigned id) {
+        st::StoneRNG rng(seed + id);
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+        while (Clock::now() < stop) {
+            Request r{ Clock::now(), static_cast<std::size_t>(rng.unbiased(0, w.accounts.size() - 1)), unit(rng) < w.wrong_fraction };
+            if (!verify_one(w, p, r)) ++failures;
+            const auto us = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - r.due).count();
+            hists[id].record(static_cast<std::uint64_t>(us));
+            ++completed;
+        }
+        };
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < concurrency; ++t)
+        pool.emplace_back(worker, t);
+    for (auto& t : pool) t.join();
+
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    for (auto& h : hists) result.hist.merge(h);
+    result.completed = completed;
+    result.failures = failures;
+    result.peak_rss = peak_rss_bytes();
+    return result;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+inline void print_header()
+{
+    std::printf("%-8s %9s %9s %9s %9s %9s %9s %9s %8s %9s %10s\n",
+        "profile", "target/s", "done/s", "p50 ms", "p90 ms", "p99 ms", "p99.9 ms", "max ms", "backlog", "drain ms", "peak MiB");
+}
+
+inline void print_row(const Profile& p, double target, const RunResult& r)
+{
+    const auto ms = [&](double q) { return r.hist.percentile(q) / 1000.0; };
+    std::printf("%2u,%-5u %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %8llu %9.1f %10.1f%s%s\n",
+        p.m_cost, p.t_cost, target, r.throughput(),
+        ms(0.50), ms(0.90), ms(0.99), ms(0.999), r.hist.max() / 1000.0,
+        static_cast<unsigned long long>(r.backlog), r.drain_ms(),
+        r.peak_rss / (1024.0 * 1024.0),
+        r.failures ? "  VERIFY FAILURES" : "",
+        r.abandoned ? "  DRAIN CAP HIT" : "");
+    std::fflush(stdout);
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+
+struct Options {
+    std::vector<Profile> profiles;
+    double qps = 0;              // open-loop target; 0 = derive from a calibration run
+    unsigned concurrency = 0;    // > 0 selects closed loop
+    unsigned threads = 0;        // server worker threads; 0 = hardware_concurrency
+    double duration = 10;        // seconds per run
+    bool sweep = false;
+    double p99_ms = 0;           // SLO for --sweep; 0 = 4 × single-request latency
+    double max_drain_ms = 0;     // drain limit for --sweep; 0 = the p99 bound
+    std::size_t accounts = 16;
+    std::uint64_t seed = 1;
+};
+
+inline void usage()
+{
+    std::puts(
+        "usage: stonekey_load [options]\n"
+        "  --profile M,T      m_cost,t_cost to test (repeatable; default 16,2)\n"
+        "  --qps X            open-loop arrival rate (default: 50% of estimated capacity)\n"
+        "  --concurrency N    closed loop with N back-to-back clients instead\n"
+        "  --threads N        verifier threads serving open-loop requests\n"
+        "  --duration S       seconds per run (default 10)\n"
+        "  --sweep            find the highest rate meeting --p99-ms for each profile\n"
+        "  --p99-ms X         p99 latency bound for --sweep\n"
+        "  --max-drain-ms X   time allowed to finish requests queued at the end\n"
+        "                     of a --sweep run (default: the p99 bound)\n"
+        "  --accounts N       distinct accounts in the workload (default 16)\n"
+        "  --seed N           arrival / account RNG seed (default 1)");
+}
+
+inline Options parse(int argc, char** argv)
+{
+    Options o;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        auto next = [&]() -> std::string {
+            if (i + 1 >= argc) throw std::invalid_argument("missing value for " + a);
+            return argv[++i];
+            };
+        if (a == "--profile") {
+            const std::string v = next();
+            const auto comma = v.find(',');
+            if (comma == std::string::npos) throw std::invalid_argument("--profile expects M,T");
+            const Profile p{ static_cast<std::uint32_t>(std::stoul(v.substr(0, comma))),
+                             static_cast<std::uint32_t>(std::stoul(v.substr(comma + 1))) };
+            // same limits as StoneKey(), checked here so they reach usage()
+            if (p.m_cost > 26) throw std::invalid_argument("--profile: m_cost too high (max 26: 4 GiB)");
+            if (p.t_cost == 0) throw std::invalid_argument("--profile: t_cost must be >= 1");
+            o.profiles.push_back(p);
+        }
+        else if (a == "--qps") {
+            o.qps = std::stod(next());
+            if (!(o.qps >= 0)) throw std::invalid_argument("--qps must be >= 0");
+        }
+        else if (a == "--concurrency") o.concurrency = static_cast<unsigned>(std::stoul(next()));
+        else if (a == "--threads") o.threads = static_cast<unsigned>(std::stoul(next()));
+        else if (a == "--duration") o.duration = std::stod(next());
+        else if (a == "--sweep") o.sweep = true;
+        else if (a == "--p99-ms") o.p99_ms = std::stod(next());
+        else if (a == "--max-drain-ms") o.max_drain_ms = std::stod(next());
+        else if (a == "--accounts") o.accounts = std::stoul(next());
+        else if (a == "--seed") o.seed = std::stoull(next());
+        else if (a == "--help" || a == "-h") { usage(); std::exit(EXIT_SUCCESS); }
+        else throw std::invalid_argument("unknown option " + a);
+    }
+    if (o.profiles.empty()) o.profiles.push_back({ 16, 2 });
+    if (o.threads == 0) o.threads = std::max(1u, std::thread::hardware_concurrency());
+    if (o.accounts == 0) o.accounts = 1;
+    return o;
+}
+
+// ============================================================================
+// Sweep: highest open-loop rate with p99 <= bound whose backlog at the end
+// of arrivals drains within the drain limit. A short drain is normal queueing;
+// a long one means the queue was still growing and the run was too short to
+// show it in p99.
+// ============================================================================
+
+inline void sweep(const Options& o, const Workload& w, const Profile& p, double service_ms)
+{
+    const double bound = o.p99_ms > 0 ? o.p99_ms : 4 * service_ms;
+    const double drain_bound = o.max_drain_ms > 0 ? o.max_drain_ms : bound;
+    const double capacity = o.threads * 1000.0 / service_ms;   // ideal, perfect scaling
+    std::printf("  sweep: p99 bound %.1f ms, drain bound %.1f ms, ideal capacity %.1f/s\n",
+        bound, drain_bound, capacity);
+
+    auto ok = [&](const RunResult& r) {
+        return r.failures == 0 && r.abandoned == 0
+            && r.p99_ms() <= bound && r.drain_ms() <= drain_bound;
+        };
+
+    double lo = 0, hi = 1.25 * capacity;
+    for (int step = 0; step < 7; ++step) {
+        const double target = (lo + hi) / 2;
+        if (target <= 0) break;
+        const RunResult r = run_open_loop(w, p, target, o.duration, o.threads, o.seed + step);
+        print_row(p, target, r);
+        (ok(r) ? lo : hi) = target;
+    }
+    std::printf("  => max sustainable rate for %u,%u: %.1f verifies/s at p99 <= %.1f ms\n\n",
+        p.m_cost, p.t_cost, lo, bound);
+}
+
+int main(int argc, char** argv)
+{
+    Options o;
+    try {
+        o = parse(argc, argv);
+    }
+    catch (const std::exception& e) {
+        std::fprintf(stderr, "stonekey_load: %s\n", e.what());
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    if (o.concurrency > 0)
+        std::printf("StoneKeyVerify load test: %u closed-loop clients, %.0f s per run\n\n", o.concurrency, o.duration);
+    else
+        std::printf("StoneKeyVerify load test: %u verifier threads, %.0f s per run\n\n", o.threads, o.duration);
+    print_header();
+
+    for (const Profile& p : o.profiles) {
+        const Workload w(p, o.accounts);
+
+        // Calibrate: single-request service time, no contention
+        LatencyHistogram cal;
+        for (int i = 0; i < 3; ++i) {
+            const auto t0 = Clock::now();
+            (void)verify_one(w, p, { t0, static_cast<std::size_t>(i) % w.accounts.size(), false });
+            cal.record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - t0).count());
+        }
+        const double service_ms = std::max(0.001, cal.percentile(0.5) / 1000.0);
+
+        if (o.concurrency > 0) {
+            print_row(p, 0, run_closed_loop(w, p, o.concurrency, o.duration, o.seed));
+        }
+        else if (o.sweep) {
+            sweep(o, w, p, service_ms);
+        }
+        else {
+            const double qps = o.qps > 0 ? o.qps : 0.5 * o.threads * 1000.0 / service_ms;
+            print_row(p, qps, run_open_loop(w, p, qps, o.duration, o.threads, o.seed));
+        }
+    }
+    return EXIT_SUCCESS;
+}
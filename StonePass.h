@@ -1,6 +1,7 @@
 #pragma once
 #define _CRT_DECLARE_NONSTDC_NAMES 1
 
+#include <climits>
 #include <iostream>
 #include <string>
 #include <string_view>
@@ -10,6 +11,7 @@
 #include "StoneHash.h"
 #include "StoneKey.h"
 #include "StoneRNG.h"
+#include "stSecret.h"
 
 
 #ifdef USE_NONPORTABLE_WINDOWS_INTERFACE
@@ -173,7 +175,7 @@ Master Password Guidance
 
 inline std::string generate_password(
     const std::string& username,
-    const std::string& master_password,
+    std::string_view master_password,   // e.g. SecretBuffer::view(); never copied
     const std::string& site_name,
     int password_length,
     int password_version = 1,
@@ -305,7 +307,8 @@ inline void generate_password_interactive()
     fields.push_back({ 1, 5,  "=== StonePass - Offline Deterministic Password Generator ===", ui::DISPLAY });
     fields.push_back({ 3, 0,  "", ui::DISPLAY }); // blank line
     fields.push_back({ 5, 5,  "Username / Email    : ", ui::STRING_INPUT, "", 0, 60 });
-    fields.push_back({ 7, 5,  "Master Password     : ", ui::STRING_INPUT, "", 0, 80 });
+    st::SecretBuffer master_password(80);
+    fields.push_back({ 7, 5,  "Master Password     : ", ui::STRING_INPUT, "", 0, 80, "", &master_password });
     fields.push_back({ 9, 5,  "Site / Domain       : ", ui::STRING_INPUT, "", 0, 80 });
     fields.push_back({ 11, 5,  "Version (counter)   : ", ui::INT_INPUT, "1", 1, 8 });     // default 1
     fields.push_back({ 13, 5,  "Length (8-64)       : ", ui::INT_INPUT, "20", 20, 3 });
@@ -317,7 +320,6 @@ inline void generate_password_interactive()
 
     if(fields[active].button_text=="Generate"){
         std::string username = fields[2].value_str;
-        std::string master_password = fields[3].value_str;
         std::string site_name = fields[4].value_str;
         int password_version = fields[5].value_int;
         int password_length = fields[6].value_int;
@@ -326,7 +328,7 @@ inline void generate_password_interactive()
         std::cout << "Please wait -- generating password: ";
         std::string result = generate_password(
             username,
-            master_password,
+            master_password.view(),
             site_name,
             password_length,
             password_version = 1,
@@ -345,7 +347,6 @@ inline void generate_password_interactive()
             std::cout << "*** PASSWORD GENERATOR ***\n";
             std::cout << "Input data\n";
             std::cout << "\tUsername = " << username << "\n";
-            std::cout << "\tMaster Password = " << master_password << "\n";
             std::cout << "\tsite_name = " << site_name << "\n";
             std::cout << "\tpassword length = " << password_length << "\n";
             std::cout << "\tpassword version = " << password_version << "\n";
@@ -369,6 +370,13 @@ inline void generate_password_interactive()
 
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdio>       // setvbuf
+#if defined(_WIN32)
+#include <io.h>         // _read
+#else
+#include <unistd.h>     // read
+#endif
 
 // Helper to trim whitespace
 std::string trim(const std::string& str) {
@@ -388,6 +396,49 @@ std::string prompt_gets(const std::string& prompt) {
     return trim(s);
 }
 
+// Read one line straight into a SecretBuffer. Bytes come one at a time from
+// the raw descriptor, not through std::cin, so no copy of the secret is left
+// in the (never wiped) stdio or iostream buffers. Surrounding whitespace is
+// trimmed in place. A line longer than the buffer is never truncated (that
+// would silently change the generated password): it is rejected and the
+// prompt repeats.
+// stdin must be unbuffered (see generate_password_interactive) so that earlier
+// prompts have not already read this line ahead.
+inline void prompt_secret(const std::string& prompt, st::SecretBuffer& secret) {
+    for (;;) {
+        std::cout << prompt;
+        std::cout.flush();
+
+        secret.clear();
+        bool overflow = false;
+        char c = 0;
+        for (;;) {
+#if defined(_WIN32)
+            const int got = _read(0, &c, 1);
+#else
+            const ssize_t got = ::read(0, &c, 1);
+            if (got < 0 && errno == EINTR)
+                continue;
+#endif
+            if (got <= 0 || c == '\n')
+                break;
+            if (secret.size() < secret.capacity())
+                secret.push_back(c);
+            else
+                overflow = true;    // keep reading to the end of the line
+        }
+        *static_cast<volatile char*>(&c) = 0;
+        std::cout << std::endl;  // forces clean separation
+
+        if (!overflow) {
+            secret.trim();
+            return;
+        }
+        secret.clear();
+        std::cout << "Too long: at most " << secret.capacity() << " characters. Please try again.\n";
+    }
+}
+
 int prompt_geti(const std::string& prompt, int min_val, int max_val = INT_MAX)
 {
     if (!prompt.empty()) {
@@ -414,10 +465,15 @@ int prompt_geti(const std::string& prompt, int min_val, int max_val = INT_MAX)
 
 // PORTABLE interface
 inline void generate_password_interactive() {
+    // Unbuffered stdin: the ordinary prompts must not read ahead into the
+    // master password line, which prompt_secret() takes from the descriptor.
+    std::setvbuf(stdin, nullptr, _IONBF, 0);
+
     std::cout << "=== StonePass - Offline Deterministic Password Generator ===\n";
     std::cout << "\n";
     std::string username        = prompt_gets("Username / Email               : ");
-    std::string master_password = prompt_gets("Master Password                : ");
+    st::SecretBuffer master_password;
+    prompt_secret("Master Password                : ", master_password);
     std::string site_name       = prompt_gets("Site / Domain                  : ");
     int password_version        = prompt_geti("Version (counter) [1-999999]   : ", 1, 999999);
     int password_length         = prompt_geti("Length [8-64]                  : ", 8, 64);
@@ -427,7 +483,7 @@ inline void generate_password_interactive() {
 
     std::string result = generate_password(
         username,
-        master_password,
+        master_password.view(),
         site_name,
         password_length,
         password_version = 1,
@@ -444,7 +500,6 @@ inline void generate_password_interactive() {
     std::cout << "*** PASSWORD GENERATOR ***\n";
     std::cout << "Input data\n";
     std::cout << "\tUsername = " << username << "\n";
-    std::cout << "\tMaster Password = " << master_password << "\n";
     std::cout << "\tsite_name = " << site_name << "\n";
     std::cout << "\tpassword length = " << password_length << "\n";
     std::cout << "\tpassword version = " << password_version << "\n";
@@ -4,6 +4,7 @@
 #include <random>
 #include <array>
 #include <cstdint>
+#include <span>
 #include <stdexcept>
 #include "StoneHash.h"
 
@@ -376,7 +377,7 @@ namespace st { // Stone namespace
         friend std::basic_ostream<CharT, Traits>&
             operator<<(std::basic_ostream<CharT, Traits>& os, const StoneRNG& rng)
         {
-            static constexpr char magic[8] = "StoneRNG";
+            static constexpr char magic[8] = { 'S', 't', 'o', 'n', 'e', 'R', 'N', 'G' }; // no terminator
             static constexpr std::uint8_t version = 1;
 
             os.write(magic, 8);
@@ -477,5 +478,148 @@ namespace st { // Stone namespace
                 p[i] = 0;
         }
     }; // class StoneRNG
+
+    /*
+    @brief L independent StoneRNG streams advanced in lockstep
+
+    Deriving one deterministic stream per record with StoneRNG(Block32) costs a
+    key-expansion permute plus one permute per 64-byte block, all scalar.
+    StoneRNGLanes keeps L keys in transposed layout (word-major, lane-minor) and
+    produces the next block of every stream with one ChaCha::permute_lanes<L>()
+    call, which the compiler vectorizes.
+
+    Lane l produces exactly the same 64-bit words, in the same order, as
+    StoneRNG(seeds[l]). Because the lanes share one block counter and one word
+    index, every call returns one word per lane. Per-lane rejection sampling
+    (StoneRNG::unbiased) consumes a data-dependent number of words, so it is not
+    offered here; draw words with operator() and reduce them per lane instead.
+
+    @tparam L  number of streams (default 8: one AVX2 register of u32 per word)
+
+    @headerfile StoneRNG.h
+    */
+    template <std::size_t L = 8>
+    class StoneRNGLanes {
+        alignas(64) u32 key[8][L]{};        // 256-bit key per lane
+        alignas(64) u32 nonce[2][L]{};      // 64-bit nonce per lane
+        u64 block_counter = 0;              // shared 64-bit block counter
+        alignas(64) ChaCha::LANES<L> buffer{}; // current block of every lane
+        size_t word_index = 8;              // 8 × u64 per ChaCha block → start exhausted
+
+    public:
+        /// Unsigned integer type produced per lane
+        using result_type = uint64_t;
+
+        static constexpr std::size_t lanes = L;
+
+        /// @brief Constructs L generators, lane l equivalent to StoneRNG(seeds[l])
+        /// @param seeds  One 32-byte seed per lane
+        ///
+        /// All L seed expansions share a single multi-lane permutation.
+        explicit StoneRNGLanes(std::span<const Block32, L> seeds)
+        {
+            alignas(64) ChaCha::LANES<L> temp{};
+            for (std::size_t l = 0; l < L; ++l)
+                for (int w = 0; w < 8; ++w)
+                    temp[w][l] = seeds[l].u32[w];   // words 8..15 stay zero, as in StoneRNG
+
+            ChaCha::permute_lanes<L>(temp, temp);
+
+            std::memcpy(key, temp[0], sizeof(key));      // words 0..7
+            std::memcpy(nonce, temp[8], sizeof(nonce));  // words 8..9
+            clear(temp, sizeof(temp));
+
+            refill_buffer();  // prime the pump
+        }
+
+        /// Copy construction is disabled — would duplicate the output streams
+        StoneRNGLanes(const StoneRNGLanes&) = delete;
+        StoneRNGLanes& operator=(const StoneRNGLanes&) = delete;
+
+        StoneRNGLanes(StoneRNGLanes&&) noexcept = default;
+        StoneRNGLanes& operator=(StoneRNGLanes&&) noexcept = default;
+
+        ~StoneRNGLanes() noexcept
+        {
+            clear(key, sizeof(key));
+            clear(nonce, sizeof(nonce));
+            clear(buffer, sizeof(buffer));
+        }
+
+        /// @brief Generates the next 64-bit value of every stream
+        /// @param out  out[l] receives the next word of lane l
+        void operator()(result_type (&out)[L])
+        {
+            if (word_index >= 8) {
+                refill_buffer();
+            }
+            const std::size_t w = 2 * word_index++;
+            for (std::size_t l = 0; l < L; ++l)
+                out[l] = buffer[w][l] | (u64(buffer[w + 1][l]) << 32);
+        }
+
+        /// @brief Discards the next @a n 64-bit values from every stream
+        /// Same semantics and complexity as StoneRNG::discard().
+        void discard(std::uint64_t n)
+        {
+            if (n == 0) return;
+
+            size_t remaining = 8 - word_index;
+            if (n < remaining) {
+                word_index += static_cast<size_t>(n);
+                return;
+            }
+
+            n -= remaining;
+            word_index = 8;
+
+            const std::uint64_t full_blocks = n / 8;
+            const std::uint64_t remainder = n % 8;
+
+            if (full_blocks > 0) {
+                if (block_counter > UINT64_MAX - full_blocks)
+                    throw std::runtime_error("StoneRNGLanes: block_counter overflow during discard");
+                block_counter += full_blocks;
+            }
+
+            if (remainder != 0) {
+                refill_buffer();
+                word_index = static_cast<size_t>(remainder);
+            }
+        }
+
+    private:
+        // One ChaCha20 block for every lane: the multi-lane form of
+        // StoneRNG::refill_buffer().
+        void refill_buffer() {
+            alignas(64) ChaCha::LANES<L> state;
+            for (std::size_t l = 0; l < L; ++l) {
+                for (int w = 0; w < 4; ++w)
+                    state[w][l] = ChaCha::ChaCha20_constants[w];
+                for (int w = 0; w < 8; ++w)
+                    state[4 + w][l] = key[w][l];
+                state[12][l] = static_cast<u32>(block_counter);
+                state[13][l] = static_cast<u32>(block_counter >> 32);
+                state[14][l] = nonce[0][l];
+                state[15][l] = nonce[1][l];
+            }
+
+            ChaCha::permute_lanes<L>(buffer, state);
+            clear(state, sizeof(state)); // state no longer needed. Clear sensitive data
+
+            word_index = 0;
+
+            ++block_counter;
+            if (block_counter == 0) {
+                throw std::runtime_error("StoneRNGLanes: key/nonce pairs exhausted");
+            }
+        }
+
+        static void clear(const void* data, const size_t nbytes) {
+            volatile uint8_t* p = (uint8_t*)data;
+            for (size_t i = 0; i < nbytes; i++)
+                p[i] = 0;
+        }
+    }; // class StoneRNGLanes
 } // namespace st
 
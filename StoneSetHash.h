@@ -0,0 +1,226 @@
+#pragma once
+
+// file StoneSetHash.h
+//
+// StoneSetHash — order-independent digest of a set or multiset, built on StoneHash
+//
+// • Header-only
+// • add() / remove() in O(1), in any order
+// • Partial digests from different threads / machines merge with +=
+// • Batch element hashing in SIMD lanes (StoneHash::hash_many)
+// • No heap allocation
+//
+// Each element is hashed with a keyed, domain-separated StoneHash, and the
+// 256-bit results are summed modulo 2^256 together with an element count
+// (MSet-Add-Hash, Clarke et al. 2003). Addition is commutative and invertible,
+// so no sorting is needed, removal is a subtraction, and two partial sums
+// simply add. digest() compresses the sum once more with StoneHash, so the
+// published value is not itself linear.
+//
+// Security note: an additive accumulator of this size resists collisions only
+// while the element key is secret. With a public (or zero) key an attacker can
+// search for colliding multisets with generalized-birthday (k-sum) methods far
+// faster than 2^128. Use a secret key when the collection may be chosen by an
+// adversary; unkeyed mode is for accidental-change detection (file sets,
+// table snapshots). For public-key adversarial use, prefer a lattice hash with
+// a much wider accumulator (e.g. LtHash, 16 Kbit).
+
+#define _CRT_DECLARE_NONSTDC_NAMES 1
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#include "StoneHash.h"
+
+namespace st {
+
+    class StoneSetHash {
+    public:
+        // ================================================================
+        // Constructors
+        // ================================================================
+
+        // Unkeyed: for detecting accidental changes only (see security note).
+        StoneSetHash() noexcept : StoneSetHash(Block32{}) {}
+
+        // Keyed: collections hashed with different keys are unrelated and
+        // cannot be merged.
+        explicit StoneSetHash(Block32 key) noexcept
+        {
+            StoneHash h(key);
+            h.update("StoneSetHash::v1::element_key");
+            element_key_ = h.hash256();
+        }
+
+        // Copyable: a copy is an independent partial digest.
+        StoneSetHash(const StoneSetHash&) noexcept = default;
+        StoneSetHash& operator=(const StoneSetHash&) noexcept = default;
+
+        ~StoneSetHash() { wipe(); }
+
+        // ================================================================
+        // Elements
+        // ================================================================
+
+        StoneSetHash& add(std::span<const std::byte> element) noexcept
+        {
+            add_digest(StoneHash::hash(element, element_key_));
+            ++count_;
+            return *this;
+        }
+
+        StoneSetHash& remove(std::span<const std::byte> element) noexcept
+        {
+            sub_digest(StoneHash::hash(element, element_key_));
+            --count_;
+            return *this;
+        }
+
+        StoneSetHash& add(std::string_view element) noexcept
+        {
+            return add(std::as_bytes(std::span(element)));
+        }
+
+        StoneSetHash& remove(std::string_view element) noexcept
+        {
+            return remove(std::as_bytes(std::span(element)));
+        }
+
+        // Batch forms: elements are hashed HASH_LANES at a time in SIMD lanes.
+        StoneSetHash& add_many(std::span<const std::span<const std::byte>> elements) noexcept
+        {
+            for_each_digest(elements, [this](const Block32& d) { add_digest(d); });
+            count_ += elements.size();
+            return *this;
+        }
+
+        StoneSetHash& remove_many(std::span<const std::span<const std::byte>> elements) noexcept
+        {
+            for_each_digest(elements, [this](const Block32& d) { sub_digest(d); });
+            count_ -= elements.size();
+            return *this;
+        }
+
+        // ================================================================
+        // Combining partial digests
+        // ================================================================
+
+        // Union of two multisets (element counts add).
+        // Throws std::invalid_argument if the two were built with different keys.
+        StoneSetHash& operator+=(const StoneSetHash& other)
+        {
+            check_same_key(other);
+            add_limbs(other.acc_.data());
+            count_ += other.count_;
+            return *this;
+        }
+
+        // Multiset difference: removes every element of other once.
+        StoneSetHash& operator-=(const StoneSetHash& other)
+        {
+            check_same_key(other);
+            sub_limbs(other.acc_.data());
+            count_ -= other.count_;
+            return *this;
+        }
+
+        friend StoneSetHash operator+(StoneSetHash a, const StoneSetHash& b) { return a += b; }
+        friend StoneSetHash operator-(StoneSetHash a, const StoneSetHash& b) { return a -= b; }
+
+        // ================================================================
+        // Output
+        // ================================================================
+
+        // Number of elements added minus elements removed (mod 2^64).
+        u64 size() const noexcept { return count_; }
+
+        // 256-bit digest of the multiset.
+        [[nodiscard]] Block32 digest() const noexcept
+        {
+            StoneHash h(element_key_);
+            h.update("StoneSetHash::v1::digest");
+            h.update(acc_);
+            h.update(count_);
+            return h.hash256();
+        }
+
+        // Equal multisets (same key) compare equal. Constant-time.
+        friend bool operator==(const StoneSetHash& a, const StoneSetHash& b) noexcept
+        {
+            u64 diff = a.count_ ^ b.count_;
+            for (std::size_t i = 0; i < 4; ++i)
+                diff |= (a.acc_[i] ^ b.acc_[i]) | (a.element_key_.u64[i] ^ b.element_key_.u64[i]);
+            return diff == 0;
+        }
+
+        void clear() noexcept
+        {
+            acc_ = {};
+            count_ = 0;
+        }
+
+    private:
+        Block32            element_key_{};
+        std::array<u64, 4> acc_{};       // little-endian 256-bit sum
+        u64                count_ = 0;
+
+        // acc_ += x, mod 2^256 (x is four little-endian limbs); branch-free carry
+        void add_limbs(const u64* x) noexcept
+        {
+            u64 carry = 0;
+            for (std::size_t i = 0; i < 4; ++i) {
+                const u64 a = acc_[i] + x[i];
+                const u64 c = a < x[i];
+                acc_[i] = a + carry;
+                carry = c | (acc_[i] < carry);
+            }
+        }
+
+        // acc_ -= x, mod 2^256
+        void sub_limbs(const u64* x) noexcept
+        {
+            u64 borrow = 0;
+            for (std::size_t i = 0; i < 4; ++i) {
+                const u64 a = acc_[i];
+                acc_[i] = a - x[i] - borrow;
+                borrow = (a < x[i]) | ((a == x[i]) & borrow);
+            }
+        }
+
+        void add_digest(const Block32& d) noexcept { add_limbs(d.u64); }
+        void sub_digest(const Block32& d) noexcept { sub_limbs(d.u64); }
+
+        template <class Fn>
+        void for_each_digest(std::span<const std::span<const std::byte>> elements, Fn&& fn) const noexcept
+        {
+            Block32 digests[StoneHash::HASH_LANES * 8];
+            constexpr std::size_t CHUNK = sizeof(digests) / sizeof(digests[0]);
+
+            for (std::size_t first = 0; first < elements.size(); first += CHUNK) {
+                const std::size_t n = std::min(CHUNK, elements.size() - first);
+                StoneHash::hash_many(elements.subspan(first, n), { digests, n }, element_key_);
+                for (std::size_t i = 0; i < n; ++i)
+                    fn(digests[i]);
+            }
+        }
+
+        void check_same_key(const StoneSetHash& other) const
+        {
+            if (!(element_key_ == other.element_key_))
+                throw std::invalid_argument("StoneSetHash: cannot combine digests built with different keys");
+        }
+
+        void wipe() noexcept
+        {
+            element_key_.clear();
+            volatile u64* p = acc_.data();
+            for (std::size_t i = 0; i < 4; ++i)
+                p[i] = 0;
+        }
+    };//class StoneSetHash
+
+} // namespace st
@@ -5,6 +5,7 @@
 
 #include "stBlock.h" // A union to allow access as different types: byte, u8, u16, u32, and u64
 
+#include <algorithm> // for std::generate, std::min
 #include <bit> // for std::rotl
 #include <cassert>
 #include <chrono>
@@ -35,6 +36,9 @@
 
         permute_block()              – Core 20-round permutation + add
                                        Two overloads: raw u32* and Block64&
+        permute_lanes<L>()           – permute_block() on L blocks at once,
+                                       transposed layout x[word][lane]
+        load_lane() / store_lane()   – move one Block64 in/out of a lane
 
         build_state()                – Two overloads:
             • Bernstein original (64-bit nonce + 64-bit counter)
@@ -154,7 +158,7 @@ namespace st {
             size_t i = 0;
             while (i < out.size()) {
                 temp = mt();
-                size_t n_to_copy = std::min(8ull, out.size() - i);
+                size_t n_to_copy = std::min<size_t>(8, out.size() - i);
                 std::memcpy(out.data() + i, &temp, n_to_copy);
                 i += n_to_copy;
             }
@@ -217,6 +221,61 @@ namespace st {
             permute_block(out.u32, in.u32);
         }
 
+        // Multi-lane permutation.
+        // 
+        // L independent blocks are stored transposed: x[w][l] is word w of lane l.
+        // Every step of the permutation is then the same operation on L adjacent
+        // u32 values, which the compiler turns into SSE/AVX/NEON code without any
+        // intrinsics. Each lane produces exactly what permute_block() would.
+        // Safe for in-place operation (out may alias in).
+        template <std::size_t L>
+        using LANES = u32[16][L];
+
+        template <std::size_t L>
+        inline void QR_lanes(u32* a, u32* b, u32* c, u32* d) noexcept
+        {
+            for (std::size_t l = 0; l < L; ++l) { a[l] += b[l]; d[l] ^= a[l]; d[l] = std::rotl(d[l], 16); }
+            for (std::size_t l = 0; l < L; ++l) { c[l] += d[l]; b[l] ^= c[l]; b[l] = std::rotl(b[l], 12); }
+            for (std::size_t l = 0; l < L; ++l) { a[l] += b[l]; d[l] ^= a[l]; d[l] = std::rotl(d[l], 8); }
+            for (std::size_t l = 0; l < L; ++l) { c[l] += d[l]; b[l] ^= c[l]; b[l] = std::rotl(b[l], 7); }
+        }
+
+        template <std::size_t L>
+        inline void permute_lanes(LANES<L>& out, const LANES<L>& in) noexcept
+        {
+            alignas(64) LANES<L> x;
+            std::memcpy(x, in, sizeof(x));
+
+            for (int r = 0; r < 10; ++r) {
+                QR_lanes<L>(x[0], x[4], x[8], x[12]);
+                QR_lanes<L>(x[1], x[5], x[9], x[13]);
+                QR_lanes<L>(x[2], x[6], x[10], x[14]);
+                QR_lanes<L>(x[3], x[7], x[11], x[15]);
+
+                QR_lanes<L>(x[0], x[5], x[10], x[15]);
+                QR_lanes<L>(x[1], x[6], x[11], x[12]);
+                QR_lanes<L>(x[2], x[7], x[8], x[13]);
+                QR_lanes<L>(x[3], x[4], x[9], x[14]);
+            }
+
+            for (int w = 0; w < 16; ++w)
+                for (std::size_t l = 0; l < L; ++l)
+                    out[w][l] = x[w][l] + in[w][l];
+        }
+
+        // Copy a block into / out of lane l of a transposed state
+        template <std::size_t L>
+        inline void load_lane(LANES<L>& x, std::size_t l, const Block64& b) noexcept
+        {
+            for (int w = 0; w < 16; ++w) x[w][l] = b.u32[w];
+        }
+
+        template <std::size_t L>
+        inline void store_lane(Block64& b, const LANES<L>& x, std::size_t l) noexcept
+        {
+            for (int w = 0; w < 16; ++w) b.u32[w] = x[w][l];
+        }
+
         // Builds original Bernstein ChaCha20 state (64-bit nonce + 64-bit block_counter)
         // *** WARNING: NOT compatible with RFC 8439 / TLS / WireGuard ***
         inline Block64 build_state(
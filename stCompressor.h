@@ -16,15 +16,29 @@
     │   update(Block64&)      – absorb one full block                     │
     │   finalize(uint64_t)    – finalize with message length (in bytes)   │
     │   wipe()                – zeroize internal state                    │
+    ├─────────────────────────────────────────────────────────────────────┤
+    │ class CompressorLanes<L>                                            │
+    │ • L Compressors advanced in lockstep with ChaCha::permute_lanes     │
+    │ • Lane l gives bit-for-bit the same result as a scalar Compressor   │
+    │                                                                     │
+    │ Interface                                                           │
+    │   CompressorLanes(const Compressor&) – every lane starts from seed  │
+    │   update(blocks[L])     – absorb one block per lane (nullptr = skip)│
+    │   finalize(len[L], out[L]) – finalize all lanes                     │
+    │   wipe()                – zeroize internal state                    │
     └─────────────────────────────────────────────────────────────────────┘
 */
 
 namespace st {
     // Compressor — compresses full 64-byte blocks using ChaCha20 permutation.
     // This is used as a building-block for st::Hash::Secure
+    template <std::size_t L> class CompressorLanes;
+
     class Compressor {
         Block64 state{}; // a union
 
+        template <std::size_t L> friend class CompressorLanes;
+
     public:
 
         void update(const Block64& block) noexcept {
@@ -53,5 +67,64 @@ namespace st {
 
         void wipe() noexcept { state.clear(); }
     };
+
+    // CompressorLanes — L independent Compressors in transposed layout.
+    // Used for batch hashing of many short messages (StoneHash::hash_many).
+    // Lanes that are given no block in an update() keep their state, so
+    // messages of different lengths can share one pass.
+    template <std::size_t L>
+    class CompressorLanes {
+        alignas(64) ChaCha::LANES<L> state{};
+
+    public:
+        explicit CompressorLanes(const Compressor& seed) noexcept {
+            for (std::size_t l = 0; l < L; ++l)
+                ChaCha::load_lane<L>(state, l, seed.state);
+        }
+
+        ~CompressorLanes() { wipe(); }
+
+        void update(const Block64* const (&blocks)[L]) noexcept {
+            alignas(64) ChaCha::LANES<L> x;
+            u32 keep[L];  // all ones for lanes without input
+
+            for (std::size_t l = 0; l < L; ++l)
+                keep[l] = blocks[l] ? 0u : ~0u;
+
+            for (int w = 0; w < 16; ++w)
+                for (std::size_t l = 0; l < L; ++l)
+                    x[w][l] = state[w][l] ^ (blocks[l] ? blocks[l]->u32[w] : 0u);
+
+            ChaCha::permute_lanes<L>(x, x);
+
+            for (int w = 0; w < 16; ++w)
+                for (std::size_t l = 0; l < L; ++l)
+                    state[w][l] = (x[w][l] & ~keep[l]) | (state[w][l] & keep[l]);
+        }
+
+        // Same as Compressor::finalize() for every lane, in one permutation.
+        void finalize(const uint64_t (&total_bytes)[L], Block64 (&out)[L]) const noexcept {
+            alignas(64) ChaCha::LANES<L> h;
+            std::memcpy(h, state, sizeof(h));
+
+            for (std::size_t l = 0; l < L; ++l) {
+                const uint64_t bit_len = std::rotl(total_bytes[l], 3);
+                h[0][l] ^= 0x01u;
+                h[12][l] ^= static_cast<u32>(bit_len);
+                h[13][l] ^= static_cast<u32>(bit_len >> 32);
+            }
+
+            ChaCha::permute_lanes<L>(h, h);
+
+            for (std::size_t l = 0; l < L; ++l)
+                ChaCha::store_lane<L>(out[l], h, l);
+        }
+
+        void wipe() noexcept {
+            volatile u32* p = &state[0][0];
+            for (std::size_t i = 0; i < 16 * L; ++i)
+                p[i] = 0;
+        }
+    };
 }//namespace st
 
@@ -0,0 +1,357 @@
+#pragma once
+// file stEncode.h
+// Description: hex, base32 and base64url text encodings for digests, keys and tokens.
+#define _CRT_DECLARE_NONSTDC_NAMES 1
+
+#include "stBlock.h" // Block<N>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+    CONTENTS
+    ┌─────────────────────────────────────────────────────────────────────┐
+    │  Sizes                                                              │
+    │      hex_size(n), base32_size(n), base64_size(n)                    │
+    ├─────────────────────────────────────────────────────────────────────┤
+    │  Encoders (always constant-time)                                    │
+    │      hex(bytes)         – lowercase hex                             │
+    │      base32(bytes)      – RFC 4648 alphabet A-Z 2-7, no padding     │
+    │      base64url(bytes)   – RFC 4648 URL-safe alphabet, no padding    │
+    │      Each: (span, char* out), (span) → string, (Block<N>) → string  │
+    ├─────────────────────────────────────────────────────────────────────┤
+    │  Decoders                                                           │
+    │      from_hex / from_base32 / from_base64url                        │
+    │      (text, span out) → bytes written, (text) → vector,             │
+    │      <N>(text) → Block<N>                                           │
+    │      Timing::Fast      – table lookup, stops at the first bad char  │
+    │      Timing::Constant  – arithmetic only, no data-dependent         │
+    │                          branches or memory access; use for secrets │
+    │      Invalid text throws std::invalid_argument.                     │
+    └─────────────────────────────────────────────────────────────────────┘
+
+    Every step is a simple loop over bytes with no lookups and no branches on
+    the data, so the compiler vectorizes it (SSE/AVX/NEON) without intrinsics.
+    Decoders accept trailing '=' padding and both letter cases for hex and
+    base32; leftover bits in the last character must be zero.
+*/
+
+namespace st {
+
+    namespace Encode {
+
+        enum class Timing { Fast, Constant };
+
+        constexpr std::size_t hex_size(std::size_t n) noexcept { return 2 * n; }
+        constexpr std::size_t base32_size(std::size_t n) noexcept { return (8 * n + 4) / 5; }
+        constexpr std::size_t base64_size(std::size_t n) noexcept { return (4 * n + 2) / 3; }
+
+        // ----------------------------------------------------------------
+        // Branch-free helpers. All values are < 256, so u32 arithmetic
+        // never overflows and the sign bit of a wrapped difference tells
+        // the comparison.
+        // ----------------------------------------------------------------
+
+        // all ones if lo <= c <= hi, else 0
+        constexpr u32 in_range(u32 c, u32 lo, u32 hi) noexcept
+        {
+            return (((c - lo) | (hi - c)) >> 31) - 1u;
+        }
+
+        // all ones if v >= k, else 0
+        constexpr u32 at_least(u32 v, u32 k) noexcept
+        {
+            return 0u - ((k - 1u - v) >> 31);
+        }
+
+        // value → character
+        constexpr char hex_char(u32 v) noexcept
+        {
+            return static_cast<char>(v + '0' + (at_least(v, 10) & ('a' - '0' - 10)));
+        }
+        constexpr char base32_char(u32 v) noexcept
+        {
+            return static_cast<char>(v + 'A' - (at_least(v, 26) & ('A' - '2' + 26)));
+        }
+        constexpr char base64_char(u32 v) noexcept
+        {
+            u32 c = v + 'A';
+            c += at_least(v, 26) & ('a' - 'A' - 26);       // a-z
+            c -= at_least(v, 52) & ('a' + 26 - '0');       // 0-9
+            c -= at_least(v, 62) & ('0' + 62 - 52 - '-');  // '-'
+            c += at_least(v, 63) & ('_' - '-' - 1);        // '_'
+            return static_cast<char>(c);
+        }
+
+        // character → value, or 0xFF if c is not in the alphabet
+        constexpr u32 hex_value(u32 c) noexcept
+        {
+            const u32 d = in_range(c, '0', '9');
+            const u32 l = in_range(c, 'a', 'f');
+            const u32 u = in_range(c, 'A', 'F');
+            return (d & (c - '0')) | (l & (c - 'a' + 10)) | (u & (c - 'A' + 10)) | (~(d | l | u) & 0xFF);
+        }
+        constexpr u32 base32_value(u32 c) noexcept
+        {
+            const u32 u = in_range(c, 'A', 'Z');
+            const u32 l = in_range(c, 'a', 'z');
+            const u32 d = in_range(c, '2', '7');
+            return (u & (c - 'A')) | (l & (c - 'a')) | (d & (c - '2' + 26)) | (~(u | l | d) & 0xFF);
+        }
+        constexpr u32 base64_value(u32 c) noexcept
+        {
+            const u32 u = in_range(c, 'A', 'Z');
+            const u32 l = in_range(c, 'a', 'z');
+            const u32 d = in_range(c, '0', '9');
+            const u32 m = in_range(c, '-', '-');
+            const u32 s = in_range(c, '_', '_');
+            return (u & (c - 'A')) | (l & (c - 'a' + 26)) | (d & (c - '0' + 52))
+                | (m & 62u) | (s & 63u) | (~(u | l | d | m | s) & 0xFF);
+        }
+
+        // 256-entry decode table for Timing::Fast, built from the functions above
+        template <u32 (*Value)(u32)>
+        struct DecodeTable {
+            std::array<u8, 256> v{};
+            constexpr DecodeTable() {
+                for (u32 c = 0; c < 256; ++c)
+                    v[c] = static_cast<u8>(Value(c));
+            }
+        };
+        template <u32 (*Value)(u32)>
+        inline constexpr DecodeTable<Value> decode_table{};
+
+        // ================================================================
+        // Encoders
+        // ================================================================
+
+        // Writes hex_size(in.size()) characters to out.
+        inline void hex(std::span<const std::byte> in, char* out) noexcept
+        {
+            const u8* p = reinterpret_cast<const u8*>(in.data());
+            const std::size_t n = in.size();
+            for (std::size_t i = 0; i < n; ++i) {
+                out[2 * i] = hex_char(p[i] >> 4);
+                out[2 * i + 1] = hex_char(p[i] & 0x0F);
+            }
+        }
+
+        // Writes base32_size(in.size()) characters to out.
+        inline void base32(std::span<const std::byte> in, char* out) noexcept
+        {
+            const u8* p = reinterpret_cast<const u8*>(in.data());
+            const std::size_t groups = in.size() / 5;
+
+            // 5 bytes → 8 quintets, then map the quintets in place
+            for (std::size_t g = 0; g < groups; ++g) {
+                const u8* s = p + 5 * g;
+                const u64 t = (u64(s[0]) << 32) | (u64(s[1]) << 24) | (u64(s[2]) << 16) | (u64(s[3]) << 8) | s[4];
+                for (int k = 0; k < 8; ++k)
+                    out[8 * g + k] = static_cast<char>((t >> (35 - 5 * k)) & 31);
+            }
+            for (std::size_t i = 0; i < 8 * groups; ++i)
+                out[i] = base32_char(static_cast<u8>(out[i]));
+
+            const std::size_t rest = in.size() - 5 * groups;
+            if (rest > 0) {
+                u8 s[5]{};
+                std::memcpy(s, p + 5 * groups, rest);
+                const u64 t = (u64(s[0]) << 32) | (u64(s[1]) << 24) | (u64(s[2]) << 16) | (u64(s[3]) << 8) | s[4];
+                for (std::size_t k = 0; k < base32_size(rest); ++k)
+                    out[8 * groups + k] = base32_char((t >> (35 - 5 * k)) & 31);
+            }
+        }
+
+        // Writes base64_size(in.size()) characters to out.
+        inline void base64url(std::span<const std::byte> in, char* out) noexcept
+        {
+            const u8* p = reinterpret_cast<const u8*>(in.data());
+            const std::size_t groups = in.size() / 3;
+
+            // 3 bytes → 4 sextets, then map the sextets in place
+            for (std::size_t g = 0; g < groups; ++g) {
+                const u8* s = p + 3 * g;
+                const u32 t = (u32(s[0]) << 16) | (u32(s[1]) << 8) | s[2];
+                out[4 * g + 0] = static_cast<char>(t >> 18);
+                out[4 * g + 1] = static_cast<char>((t >> 12) & 63);
+                out[4 * g + 2] = static_cast<char>((t >> 6) & 63);
+                out[4 * g + 3] = static_cast<char>(t & 63);
+            }
+            for (std::size_t i = 0; i < 4 * groups; ++i)
+                out[i] = base64_char(static_cast<u8>(out[i]));
+
+            const std::size_t rest = in.size() - 3 * groups;
+            if (rest > 0) {
+                u8 s[3]{};
+                std::memcpy(s, p + 3 * groups, rest);
+                const u32 t = (u32(s[0]) << 16) | (u32(s[1]) << 8) | s[2];
+                for (std::size_t k = 0; k < base64_size(rest); ++k)
+                    out[4 * groups + k] = base64_char((t >> (18 - 6 * k)) & 63);
+            }
+        }
+
+        inline std::string hex(std::span<const std::byte> in)
+        {
+            std::string s(hex_size(in.size()), '\0');
+            hex(in, s.data());
+            return s;
+        }
+        inline std::string base32(std::span<const std::byte> in)
+        {
+            std::string s(base32_size(in.size()), '\0');
+            base32(in, s.data());
+            return s;
+        }
+        inline std::string base64url(std::span<const std::byte> in)
+        {
+            std::string s(base64_size(in.size()), '\0');
+            base64url(in, s.data());
+            return s;
+        }
+
+        template <std::size_t N>
+        std::string hex(const Block<N>& b) { return hex(std::span<const std::byte>(b.bytes, N)); }
+        template <std::size_t N>
+        std::string base32(const Block<N>& b) { return base32(std::span<const std::byte>(b.bytes, N)); }
+        template <std::size_t N>
+        std::string base64url(const Block<N>& b) { return base64url(std::span<const std::byte>(b.bytes, N)); }
+
+        // ================================================================
+        // Decoders
+        // ================================================================
+
+        // Shared decoder for the power-of-two alphabets. Maps characters to
+        // values in chunks (vectorizable; the constant-time map is pure
+        // arithmetic) and packs BITS bits per character into bytes.
+        template <unsigned BITS, u32 (*Value)(u32)>
+        std::size_t decode(std::string_view text, std::span<std::byte> out, Timing timing, const char* name)
+        {
+            while (!text.empty() && text.back() == '=')
+                text.remove_suffix(1);
+
+            const std::size_t n_bytes = text.size() * BITS / 8;
+            const std::size_t spare = text.size() * BITS % 8;   // leftover bits in the last char
+            if (spare >= BITS)
+                throw std::invalid_argument(std::string(name) + ": invalid length");
+            if (out.size() < n_bytes)
+                throw std::invalid_argument(std::string(name) + ": output buffer too small");
+
+            u8* o = reinterpret_cast<u8*>(out.data());
+            u32 bad = 0;      // non-zero if any character was outside the alphabet
+            u32 acc = 0;      // bit accumulator, at most BITS + 7 bits used
+            unsigned nbits = 0;
+            std::size_t w = 0;
+
+            constexpr std::size_t CHUNK = 64;
+            u8 v[CHUNK];
+            for (std::size_t i = 0; i < text.size(); i += CHUNK) {
+                const std::size_t len = std::min(CHUNK, text.size() - i);
+                const u8* c = reinterpret_cast<const u8*>(text.data() + i);
+
+                if (timing == Timing::Constant) {
+                    for (std::size_t k = 0; k < len; ++k) {
+                        const u32 x = Value(c[k]);
+                        bad |= x >> BITS;
+                        v[k] = static_cast<u8>(x);
+                    }
+                }
+                else {
+                    for (std::size_t k = 0; k < len; ++k) {
+                        v[k] = decode_table<Value>.v[c[k]];
+                        if (v[k] == 0xFF)
+                            throw std::invalid_argument(std::string(name) + ": invalid character");
+                    }
+                }
+
+                for (std::size_t k = 0; k < len; ++k) {
+                    acc = (acc << BITS) | (v[k] & ((1u << BITS) - 1));
+                    nbits += BITS;
+                    if (nbits >= 8) {
+                        nbits -= 8;
+                        o[w++] = static_cast<u8>(acc >> nbits);
+                    }
+                }
+            }
+            bad |= acc & ((1u << nbits) - 1);  // non-canonical trailing bits
+
+            if (bad != 0) {
+                for (std::size_t k = 0; k < w; ++k)
+                    o[k] = 0;
+                throw std::invalid_argument(std::string(name) + ": invalid character");
+            }
+            return w;
+        }
+
+        // Decode into out; returns the number of bytes written.
+        inline std::size_t from_hex(std::string_view text, std::span<std::byte> out, Timing timing = Timing::Fast)
+        {
+            if (text.size() % 2 != 0)
+                throw std::invalid_argument("from_hex: invalid length");
+            return decode<4, hex_value>(text, out, timing, "from_hex");
+        }
+        inline std::size_t from_base32(std::string_view text, std::span<std::byte> out, Timing timing = Timing::Fast)
+        {
+            return decode<5, base32_value>(text, out, timing, "from_base32");
+        }
+        inline std::size_t from_base64url(std::string_view text, std::span<std::byte> out, Timing timing = Timing::Fast)
+        {
+            return decode<6, base64_value>(text, out, timing, "from_base64url");
+        }
+
+        inline std::vector<std::byte> from_hex(std::string_view text, Timing timing = Timing::Fast)
+        {
+            std::vector<std::byte> v(text.size() / 2);
+            v.resize(from_hex(text, v, timing));
+            return v;
+        }
+        inline std::vector<std::byte> from_base32(std::string_view text, Timing timing = Timing::Fast)
+        {
+            std::vector<std::byte> v(text.size() * 5 / 8);
+            v.resize(from_base32(text, v, timing));
+            return v;
+        }
+        inline std::vector<std::byte> from_base64url(std::string_view text, Timing timing = Timing::Fast)
+        {
+            std::vector<std::byte> v(text.size() * 6 / 8);
+            v.resize(from_base64url(text, v, timing));
+            return v;
+        }
+
+        // Decode exactly N bytes, e.g. Encode::from_hex<32>(text) → Block32
+        template <std::size_t N>
+        Block<N> from_hex(std::string_view text, Timing timing = Timing::Fast)
+        {
+            if (text.size() != hex_size(N))
+                throw std::invalid_argument("from_hex: wrong length for block");
+            Block<N> b;
+            from_hex(text, std::span<std::byte>(b.bytes, N), timing);
+            return b;
+        }
+        template <std::size_t N>
+        Block<N> from_base32(std::string_view text, Timing timing = Timing::Fast)
+        {
+            while (!text.empty() && text.back() == '=') text.remove_suffix(1);
+            if (text.size() != base32_size(N))
+                throw std::invalid_argument("from_base32: wrong length for block");
+            Block<N> b;
+            from_base32(text, std::span<std::byte>(b.bytes, N), timing);
+            return b;
+        }
+        template <std::size_t N>
+        Block<N> from_base64url(std::string_view text, Timing timing = Timing::Fast)
+        {
+            while (!text.empty() && text.back() == '=') text.remove_suffix(1);
+            if (text.size() != base64_size(N))
+                throw std::invalid_argument("from_base64url: wrong length for block");
+            Block<N> b;
+            from_base64url(text, std::span<std::byte>(b.bytes, N), timing);
+            return b;
+        }
+
+    }// namespace Encode
+}// namespace st
@@ -0,0 +1,192 @@
+#pragma once
+// file stSecret.h
+// Description: SecretBuffer — fixed-capacity, page-locked storage for a password.
+#define _CRT_DECLARE_NONSTDC_NAMES 1
+
+#include <cstddef>
+#include <cstring>
+#include <new>          // std::bad_alloc
+#include <stdexcept>
+#include <string_view>
+#include <utility>      // std::exchange
+
+#if defined(_WIN32)
+#include "windows_fix.h" // VirtualAlloc, VirtualLock
+#else
+#include <sys/mman.h>    // mmap, mlock, madvise
+#include <unistd.h>      // sysconf
+#endif
+
+/*
+    CONTENTS
+    ┌─────────────────────────────────────────────────────────────────────┐
+    │ class SecretBuffer                                                  │
+    │ • Holds a secret (master password) in its own locked pages          │
+    │ • Capacity fixed at construction: never grows, never reallocates,   │
+    │   so no stale copy is ever left behind on the free heap             │
+    │ • Pages are mlock'ed / VirtualLock'ed (not written to swap) and     │
+    │   excluded from core dumps where the OS allows it                   │
+    │ • Wiped with volatile writes on clear(), pop_back() and destruction │
+    │ • Move-only; hand it to APIs as a std::string_view via view()       │
+    │                                                                     │
+    │ Interface                                                           │
+    │   SecretBuffer(capacity)       – allocate and lock                  │
+    │   push_back(c) / pop_back()    – edit in place (readers, UIs)       │
+    │   trim()                       – strip surrounding whitespace       │
+    │   view(), size(), empty()      – read access, no copy               │
+    │   clear()                      – wipe contents, keep the pages      │
+    │   is_locked()                  – false if the OS refused to lock    │
+    └─────────────────────────────────────────────────────────────────────┘
+*/
+
+namespace st {
+
+    class SecretBuffer {
+        char*       data_ = nullptr;
+        std::size_t size_ = 0;
+        std::size_t capacity_ = 0;
+        std::size_t mapped_ = 0;     // bytes actually allocated (whole pages)
+        bool        locked_ = false;
+
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+        // Allocates whole pages for `capacity` bytes and tries to lock them.
+        // Locking can fail when RLIMIT_MEMLOCK is exhausted; the buffer still
+        // works but may be paged out. Check is_locked() if that matters.
+        explicit SecretBuffer(std::size_t capacity = DEFAULT_CAPACITY)
+            : capacity_(capacity)
+        {
+#if defined(_WIN32)
+            SYSTEM_INFO si;
+            GetSystemInfo(&si);
+            const std::size_t page = si.dwPageSize;
+#else
+            const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+            mapped_ = ((capacity ? capacity : 1) + page - 1) / page * page;
+
+#if defined(_WIN32)
+            data_ = static_cast<char*>(VirtualAlloc(nullptr, mapped_, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+            if (!data_)
+                throw std::bad_alloc();
+            locked_ = VirtualLock(data_, mapped_) != 0;
+#else
+            void* p = ::mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED)
+                throw std::bad_alloc();
+            data_ = static_cast<char*>(p);
+            locked_ = ::mlock(data_, mapped_) == 0;
+#if defined(MADV_DONTDUMP)
+            ::madvise(data_, mapped_, MADV_DONTDUMP);
+#endif
+#endif
+        }
+
+        ~SecretBuffer() { release(); }
+
+        // Copying would duplicate the secret. Moves transfer the pages.
+        SecretBuffer(const SecretBuffer&) = delete;
+        SecretBuffer& operator=(const SecretBuffer&) = delete;
+
+        SecretBuffer(SecretBuffer&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)),
+              size_(std::exchange(other.size_, 0)),
+              capacity_(std::exchange(other.capacity_, 0)),
+              mapped_(std::exchange(other.mapped_, 0)),
+              locked_(std::exchange(other.locked_, false))
+        {
+        }
+
+        SecretBuffer& operator=(SecretBuffer&& other) noexcept
+        {
+            if (this != &other) {
+                release();
+                data_ = std::exchange(other.data_, nullptr);
+                size_ = std::exchange(other.size_, 0);
+                capacity_ = std::exchange(other.capacity_, 0);
+                mapped_ = std::exchange(other.mapped_, 0);
+                locked_ = std::exchange(other.locked_, false);
+            }
+            return *this;
+        }
+
+        // ---------------
+        // Access
+        // ---------------
+
+        std::string_view view() const noexcept { return { data_, size_ }; }
+        std::size_t size() const noexcept { return size_; }
+        std::size_t capacity() const noexcept { return capacity_; }
+        bool empty() const noexcept { return size_ == 0; }
+        bool is_locked() const noexcept { return locked_; }
+
+        // ---------------
+        // Editing
+        // ---------------
+
+        void push_back(char c)
+        {
+            if (size_ == capacity_)
+                throw std::length_error("SecretBuffer: capacity exceeded");
+            data_[size_++] = c;
+        }
+
+        void pop_back() noexcept
+        {
+            if (size_ > 0)
+                wipe(data_ + --size_, 1);
+        }
+
+        // Remove leading and trailing whitespace in place.
+        void trim() noexcept
+        {
+            std::size_t begin = 0, end = size_;
+            while (begin < end && is_space(data_[begin])) ++begin;
+            while (end > begin && is_space(data_[end - 1])) --end;
+
+            const std::size_t n = end - begin;
+            if (begin > 0)
+                std::memmove(data_, data_ + begin, n);
+            wipe(data_ + n, size_ - n);
+            size_ = n;
+        }
+
+        void clear() noexcept
+        {
+            wipe(data_, size_);
+            size_ = 0;
+        }
+
+    private:
+        static bool is_space(char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+        }
+
+        static void wipe(char* p, std::size_t n) noexcept
+        {
+            volatile char* v = p;
+            for (std::size_t i = 0; i < n; ++i)
+                v[i] = 0;
+        }
+
+        void release() noexcept
+        {
+            if (!data_)
+                return;
+            wipe(data_, mapped_);
+#if defined(_WIN32)
+            if (locked_) VirtualUnlock(data_, mapped_);
+            VirtualFree(data_, 0, MEM_RELEASE);
+#else
+            if (locked_) ::munlock(data_, mapped_);
+            ::munmap(data_, mapped_);
+#endif
+            data_ = nullptr;
+            size_ = capacity_ = mapped_ = 0;
+            locked_ = false;
+        }
+    };
+
+}// namespace st
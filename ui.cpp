@@ -89,11 +89,21 @@ namespace ui {
                 if (focused) set_highlight();
 
                 if (f.type == STRING_INPUT) {
-                    std::cout << f.value_str;
+                    // A secret is drawn as one '*' per character: its text must
+                    // never reach the (unwiped) stdout buffer or the console.
+                    int len;
+                    if (f.secret) {
+                        len = (int)f.secret->size();
+                        for (int k = 0; k < len; ++k)
+                            std::cout << '*';
+                    }
+                    else {
+                        len = (int)f.value_str.length();
+                        std::cout << f.value_str;
+                    }
 
                     if (focused) {
                         // ← only when active: draw padding + blinking cursor
-                        int len = (int)f.value_str.length();
                         bool show_cursor = (GetTickCount() / 400) % 2;
                         for (int k = len; k < f.max_len; ++k) {
                             std::cout << (k == len && show_cursor ? '_' : ' ');
@@ -101,7 +111,7 @@ namespace ui {
                     }
                     else {
                         // ← when inactive: just erase any previous longer text
-                        for (int k = (int)f.value_str.length(); k < f.max_len; ++k)
+                        for (int k = len; k < f.max_len; ++k)
                             std::cout << ' ';
                     }
                 }
@@ -166,7 +176,10 @@ namespace ui {
             }
             else if (ch == 8) { // Backspace
                 auto& f = fields[active];
-                if (f.type == STRING_INPUT && !f.value_str.empty()) {
+                if (f.type == STRING_INPUT && f.secret) {
+                    f.secret->pop_back();
+                }
+                else if (f.type == STRING_INPUT && !f.value_str.empty()) {
                     f.value_str.pop_back();
                 }
                 else if (f.type == INT_INPUT && !f.value_str.empty()) {
@@ -175,7 +188,11 @@ namespace ui {
             }
             else if (ch >= 32 && ch <= 126) { // alpha, digits, symbols
                 auto& f = fields[active];
-                if (f.type == STRING_INPUT && (int)f.value_str.length() < f.max_len)
+                if (f.type == STRING_INPUT && f.secret) {
+                    if ((int)f.secret->size() < f.max_len && f.secret->size() < f.secret->capacity())
+                        f.secret->push_back((char)ch);
+                }
+                else if (f.type == STRING_INPUT && (int)f.value_str.length() < f.max_len)
                     f.value_str += (char)ch;
                 else if (f.type == INT_INPUT) {
                     if ((ch == '-' && f.value_str.empty()) || isdigit(ch)) {
@@ -4,6 +4,7 @@
 #include <string>
 #include <vector>
 #include "windows_fix.h"
+#include "stSecret.h"
 
 namespace ui {
 
@@ -20,6 +21,7 @@ namespace ui {
         int         value_int = 0;
         int         max_len = 30;
         std::string button_text;
+        st::SecretBuffer* secret = nullptr; // STRING_INPUT: keystrokes go here instead of value_str
     };
 
     using FIELDS = std::vector<InputField>;